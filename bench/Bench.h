@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace we::bench {
+// Google Benchmark style loop state:
+//     BENCH(name) { for (auto _ : state) { ... } state.setItems(n); }
+class State {
+    size_t iterations;
+    size_t items{};
+
+public:
+    explicit State(size_t iterations) : iterations(iterations) {}
+
+    // user provided, so an unused loop variable doesn't warn
+    struct Value {
+        Value() {}
+        ~Value() {}
+    };
+
+    struct Iterator {
+        size_t left;
+
+        bool      operator!=(Iterator const&) const { return left != 0; }
+        Iterator& operator++() {
+            --left;
+            return *this;
+        }
+        Value operator*() const { return {}; }
+    };
+
+    Iterator begin() const { return {iterations}; }
+
+    Iterator end() const { return {0}; }
+
+    size_t getIterations() const { return iterations; }
+
+    // items processed per iteration, reported as a rate
+    void setItems(size_t n) { items = n; }
+
+    size_t getItems() const { return items; }
+};
+
+struct Benchmark {
+    std::string_view           name;
+    std::function<void(State&)> fn;
+};
+
+inline std::vector<Benchmark>& registry() {
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+struct Registrar {
+    Registrar(std::string_view name, std::function<void(State&)> fn) {
+        registry().push_back({name, std::move(fn)});
+    }
+};
+
+inline void const* volatile sink;
+
+// Keeps value observable so the work producing it isn't optimized away.
+template <class T>
+inline void doNotOptimize(T const& value) {
+    sink = &value;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+} // namespace we::bench
+
+#define WE_BENCH_CONCAT_(a, b) a##b
+#define WE_BENCH_CONCAT(a, b)  WE_BENCH_CONCAT_(a, b)
+
+#define BENCH(NAME)                                                                      \
+    static void WE_BENCH_CONCAT(bench_, NAME)(::we::bench::State & state);               \
+    static ::we::bench::Registrar WE_BENCH_CONCAT(registrar_, NAME){                      \
+        #NAME,                                                                           \
+        WE_BENCH_CONCAT(bench_, NAME)                                                    \
+    };                                                                                   \
+    static void WE_BENCH_CONCAT(bench_, NAME)(::we::bench::State & state)
@@ -0,0 +1,60 @@
+#include "Bench.h"
+#include "utils/Blur.h"
+
+#include <cmath>
+#include <random>
+
+using namespace we;
+using namespace we::bench;
+
+namespace {
+constexpr int size = 512;
+
+// Rolling terrain with noise, its weights masking a disc like a round brush.
+struct Heightmap {
+    std::vector<float> heights;
+    std::vector<float> weights;
+};
+
+Heightmap const& heightmap() {
+    static auto res = [] {
+        std::mt19937                          rng{42};
+        std::uniform_real_distribution<float> noise{-2, 2};
+        Heightmap                             map;
+        map.heights.resize((size_t)size * size);
+        map.weights.resize((size_t)size * size);
+        for (int x = 0; x < size; ++x) {
+            for (int z = 0; z < size; ++z) {
+                auto i         = (size_t)x * size + z;
+                map.heights[i] = 64 + 16 * std::sin(x * 0.05f) * std::cos(z * 0.03f)
+                               + noise(rng);
+                auto dx        = x - size / 2;
+                auto dz        = z - size / 2;
+                map.weights[i] = dx * dx + dz * dz <= size * size / 4 ? 1.0f : 0.0f;
+            }
+        }
+        return map;
+    }();
+    return res;
+}
+
+void blur(State& state, HeightmapBlur::Mode mode, int radius) {
+    HeightmapBlur      blur{radius, -1, mode};
+    std::vector<float> heights;
+    for (auto _ : state) {
+        heights = heightmap().heights;
+        blur.apply(heights, heightmap().weights, size, size);
+        doNotOptimize(heights.data());
+    }
+    state.setItems((size_t)size * size);
+}
+} // namespace
+
+// Either side of HeightmapBlur::boxRadiusThreshold.
+BENCH(HeightmapBlurGaussian) { blur(state, HeightmapBlur::Mode::Gaussian, 16); }
+
+BENCH(HeightmapBlurBox) { blur(state, HeightmapBlur::Mode::Box, 16); }
+
+BENCH(HeightmapBlurGaussianWide) { blur(state, HeightmapBlur::Mode::Gaussian, 64); }
+
+BENCH(HeightmapBlurBoxWide) { blur(state, HeightmapBlur::Mode::Box, 64); }
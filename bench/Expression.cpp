@@ -0,0 +1,178 @@
+#include "Bench.h"
+#include "utils/Expression.h"
+#include "utils/ImplicitOctree.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace we;
+using namespace we::bench;
+
+namespace {
+constexpr std::string_view variables[]{"x", "y", "z"};
+
+// A torus with a sine ripple, normalized over a 64 block cube like //gen.
+Expression const& shape() {
+    static auto res = *Expression::compile(
+        "(0.7 - sqrt(x^2 + z^2))^2 + y^2 < 0.04 + 0.01 * sin(8 * x)",
+        variables
+    );
+    return res;
+}
+
+constexpr int size = 64;
+
+template <class T>
+T normalize(T v) {
+    return v * T(2.0 / size) - T(1);
+}
+} // namespace
+
+BENCH(ExpressionCompile) {
+    for (auto _ : state) {
+        auto res = Expression::compile(
+            "(0.7 - sqrt(x^2 + z^2))^2 + y^2 < 0.04 + 0.01 * sin(8 * x)",
+            variables
+        );
+        doNotOptimize(res);
+    }
+    state.setItems(1);
+}
+
+// Nesting far past the parser's limit, which has to fail at the limit instead of
+// overflowing the stack. Aborts the run if either compiles.
+BENCH(ExpressionCompileDeep) {
+    constexpr size_t depth = 100000;
+    std::string      parens(depth, '(');
+    parens += 'x';
+    parens.append(depth, ')');
+    std::string negations(depth, '-');
+    negations += 'x';
+    for (auto _ : state) {
+        for (std::string_view src : {parens, negations}) {
+            auto res = Expression::compile(src, variables);
+            if (res) {
+                std::fputs("ExpressionCompileDeep: too deep, yet compiled\n", stderr);
+                std::abort();
+            }
+            doNotOptimize(res);
+        }
+    }
+    state.setItems(2);
+}
+
+BENCH(ExpressionEvalDouble) {
+    size_t inside{};
+    for (auto _ : state) {
+        inside = 0;
+        for (int x = 0; x < size; ++x)
+            for (int y = 0; y < size; ++y)
+                for (int z = 0; z < size; ++z) {
+                    double vars[]{normalize(x + 0.5), normalize(y + 0.5), normalize(z + 0.5)};
+                    inside += shape().eval(std::span<double const>{vars}) > 0.5;
+                }
+        doNotOptimize(inside);
+    }
+    state.setItems(size * size * size);
+}
+
+BENCH(ExpressionEvalInterval) {
+    std::vector<Interval> results;
+    for (auto _ : state) {
+        results.clear();
+        for (int x = 0; x < size; x += 4)
+            for (int y = 0; y < size; y += 4)
+                for (int z = 0; z < size; z += 4) {
+                    Interval vars[]{
+                        {normalize((double)x), normalize(x + 4.0)},
+                        {normalize((double)y), normalize(y + 4.0)},
+                        {normalize((double)z), normalize(z + 4.0)},
+                    };
+                    results.push_back(shape().eval(std::span<Interval const>{vars}));
+                }
+        doNotOptimize(results.data());
+    }
+    state.setItems(results.size());
+}
+
+// The octree walk //gen runs, interval bounds deciding whole cells.
+BENCH(ExpressionImplicitOctree) {
+    auto   box = BoundingBox{{0, 0, 0}, {size - 1, size - 1, size - 1}};
+    size_t count{};
+    for (auto _ : state) {
+        count = 0;
+        forEachImplicitBlock(
+            box,
+            false,
+            [](BoundingBox const& cell) {
+                Interval vars[]{
+                    {normalize((double)cell.min.x), normalize(cell.max.x + 1.0)},
+                    {normalize((double)cell.min.y), normalize(cell.max.y + 1.0)},
+                    {normalize((double)cell.min.z), normalize(cell.max.z + 1.0)},
+                };
+                return shape().eval(std::span<Interval const>{vars});
+            },
+            [](BlockPos const& pos) {
+                double vars[]{
+                    normalize(pos.x + 0.5),
+                    normalize(pos.y + 0.5),
+                    normalize(pos.z + 0.5)
+                };
+                return shape().eval(std::span<double const>{vars}) > 0.5;
+            },
+            [&](BlockPos const&) { count++; }
+        );
+        doNotOptimize(count);
+    }
+    state.setItems(size * size * size);
+}
+
+// Leaves the domain of sqrt, log, pow and fmod inside the box, where the scalar
+// result is NaN and so false. Aborts the run unless the octree emits exactly the
+// blocks per block evaluation does.
+BENCH(ExpressionImplicitOctreeDomain) {
+    auto expression = *Expression::compile(
+        "sqrt(1 - x^2 - z^2) > y || log(x) > -0.1 || (-z)^1.5 > 0.8"
+        " || x % (y + z) > 0.9",
+        variables
+    );
+    auto bound = [&](BoundingBox const& cell) {
+        Interval vars[]{
+            {normalize((double)cell.min.x), normalize(cell.max.x + 1.0)},
+            {normalize((double)cell.min.y), normalize(cell.max.y + 1.0)},
+            {normalize((double)cell.min.z), normalize(cell.max.z + 1.0)},
+        };
+        return expression.eval(std::span<Interval const>{vars});
+    };
+    auto test = [&](BlockPos const& pos) {
+        double vars[]{
+            normalize(pos.x + 0.5),
+            normalize(pos.y + 0.5),
+            normalize(pos.z + 0.5)
+        };
+        return expression.eval(std::span<double const>{vars}) > 0.5;
+    };
+    auto index = [](BlockPos const& pos) {
+        return ((size_t)pos.x * size + pos.y) * size + pos.z;
+    };
+
+    std::vector<bool> expected((size_t)size * size * size);
+    for (int x = 0; x < size; ++x)
+        for (int y = 0; y < size; ++y)
+            for (int z = 0; z < size; ++z) expected[index({x, y, z})] = test({x, y, z});
+
+    auto              box = BoundingBox{{0, 0, 0}, {size - 1, size - 1, size - 1}};
+    std::vector<bool> emitted(expected.size());
+    for (auto _ : state) {
+        emitted.assign(emitted.size(), false);
+        forEachImplicitBlock(box, false, bound, test, [&](BlockPos const& pos) {
+            emitted[index(pos)] = true;
+        });
+        doNotOptimize(emitted);
+    }
+    if (emitted != expected) {
+        std::fputs("ExpressionImplicitOctreeDomain: octree differs\n", stderr);
+        std::abort();
+    }
+    state.setItems(size * size * size);
+}
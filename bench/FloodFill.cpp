@@ -0,0 +1,145 @@
+#include "Bench.h"
+#include "utils/FloodFill.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <queue>
+
+using namespace we;
+using namespace we::bench;
+
+namespace {
+constexpr int radius = 48, side = 2 * radius + 1;
+
+BoundingBox const box{BlockPos{-radius}, BlockPos{radius}};
+
+size_t index(BlockPos const& pos) {
+    return ((size_t)(pos.y + radius) * side + (pos.z + radius)) * side + (pos.x + radius);
+}
+
+// About a third of the cells are solid, scattered by a hash so the open cells form
+// caves with plenty of dead ends.
+std::vector<char> const& solid() {
+    static auto res = [] {
+        std::vector<char> grid((size_t)side * side * side);
+        for (int y = -radius; y <= radius; ++y)
+            for (int z = -radius; z <= radius; ++z)
+                for (int x = -radius; x <= radius; ++x) {
+                    uint32_t h = (uint32_t)x * 73856093u ^ (uint32_t)y * 19349663u
+                               ^ (uint32_t)z * 83492791u;
+                    h          = (h ^ (h >> 13)) * 0x5bd1e995;
+                    grid[index({x, y, z})] = (h >> 16) % 3 == 0;
+                }
+        grid[index({0, 0, 0})] = false;
+        return grid;
+    }();
+    return res;
+}
+
+bool open(BlockPos const& pos) { return !solid()[index(pos)]; }
+
+struct Filled {
+    std::vector<char>          cells;
+    size_t                     count{};
+    std::optional<BoundingBox> box;
+
+    bool operator==(Filled const& o) const {
+        auto corners = [](std::optional<BoundingBox> const& box) {
+            return box.transform([](auto& b) { return std::pair{b.min, b.max}; });
+        };
+        return cells == o.cells && count == o.count && corners(box) == corners(o.box);
+    }
+};
+
+// Plain breadth first search over the neighbour offsets of the connectivity.
+Filled reference(BlockPos const& seed, Connectivity connectivity) {
+    Filled res{std::vector<char>(solid().size())};
+    if (!box.contains(seed) || !open(seed)) {
+        return res;
+    }
+    std::queue<BlockPos> todo;
+    auto                 visit = [&](BlockPos const& pos) {
+        if (!box.contains(pos) || res.cells[index(pos)] || !open(pos)) {
+            return;
+        }
+        res.cells[index(pos)] = true;
+        res.count++;
+        res.box = res.box ? res.box->merge(pos) : BoundingBox{pos};
+        todo.push(pos);
+    };
+    visit(seed);
+    while (!todo.empty()) {
+        auto pos = todo.front();
+        todo.pop();
+        for (int dy = -1; dy <= 1; ++dy)
+            for (int dz = -1; dz <= 1; ++dz)
+                for (int dx = -1; dx <= 1; ++dx) {
+                    int  axes  = (dx != 0) + (dy != 0) + (dz != 0);
+                    bool edges = connectivity == Connectivity::TwentySix;
+                    if (axes == 1 || (axes > 1 && edges)) {
+                        visit(pos + BlockPos{dx, dy, dz});
+                    }
+                }
+    }
+    return res;
+}
+
+// Fills from seed with a fresh FloodFill, aborting if a cell is tested twice.
+Filled flood(BlockPos const& seed, Connectivity connectivity) {
+    FloodFill         fill{box};
+    Filled            res{std::vector<char>(solid().size())};
+    std::vector<char> tested(solid().size());
+    res.count = fill.fill(
+        seed,
+        connectivity,
+        [&](BlockPos const& pos) {
+            if (tested[index(pos)]++) {
+                std::fputs("FloodFillMatchesSearch: a cell was tested twice\n", stderr);
+                std::abort();
+            }
+            return open(pos);
+        },
+        [&](BlockPos const& pos) { res.cells[index(pos)] = true; }
+    );
+    res.box = fill.getFilledBox();
+    return res;
+}
+
+void check(BlockPos const& seed, Connectivity connectivity) {
+    if (flood(seed, connectivity) != reference(seed, connectivity)) {
+        std::fputs("FloodFillMatchesSearch: fill differs from the search\n", stderr);
+        std::abort();
+    }
+}
+
+void run(State& state, Connectivity connectivity) {
+    FloodFill fill{box};
+    size_t    items{};
+    for (auto _ : state) {
+        fill.reset(box);
+        items = fill.fill({0, 0, 0}, connectivity, open, [](BlockPos const&) {});
+        doNotOptimize(items);
+    }
+    state.setItems(items);
+}
+} // namespace
+
+// Fills from the open centre, from outside the box and from a solid cell, each
+// compared with the search.
+BENCH(FloodFillMatchesSearch) {
+    auto     wall = (int)(std::ranges::find(solid(), true) - solid().begin());
+    BlockPos rejected{wall % side, wall / side / side, wall / side % side};
+    BlockPos seeds[]{BlockPos{0}, BlockPos{radius + 1, 0, 0}, rejected - radius};
+    for (auto _ : state) {
+        for (auto connectivity : {Connectivity::Six, Connectivity::TwentySix}) {
+            for (auto& seed : seeds) {
+                check(seed, connectivity);
+            }
+        }
+    }
+    state.setItems(6);
+}
+
+BENCH(FloodFillSix) { run(state, Connectivity::Six); }
+
+BENCH(FloodFillTwentySix) { run(state, Connectivity::TwentySix); }
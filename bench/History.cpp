@@ -0,0 +1,229 @@
+#include "Bench.h"
+#include "data/History.h"
+#include "region/Region.h"
+#include "utils/Spans.h"
+#include "world/BiomeEdit.h"
+#include "world/BlockHistogram.h"
+#include "world/BlockMove.h"
+#include "world/BlockReplace.h"
+#include "world/ColumnSnapshot.h"
+#include "world/SurfaceFinder.h"
+
+#include <mc/world/level/BedrockBlocks.h>
+#include <mc/world/level/biome/Biome.h>
+#include <mc/world/level/block/Block.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+using namespace we;
+using namespace we::bench;
+
+namespace {
+Block const stone{"minecraft:stone"};
+Block const dirt{"minecraft:dirt"};
+Block const glass{"minecraft:glass"};
+
+BlockPair pair(Block const& block) { return {&block, BedrockBlocks::mAir}; }
+
+constexpr int radius = 32;
+
+// Every iteration writes the other block, so each one changes the whole shape.
+Block const& alternate(size_t& i) { return ++i % 2 ? stone : dirt; }
+
+// A noisy terrain of stone, dirt and glass over a 128 block square.
+BlockSource& terrain() {
+    static BlockSource res = [] {
+        BlockSource world;
+        for (int x = -64; x < 64; ++x)
+            for (int z = -64; z < 64; ++z) {
+                int height = 48 + (x * x + 3 * z) % 17;
+                for (int y = 0; y < height; ++y) {
+                    auto& block = (x ^ y ^ z) % 7 == 0 ? glass : y > height - 4 ? dirt : stone;
+                    world.setBlock({x, y, z}, block, 0, nullptr, nullptr);
+                }
+            }
+        return world;
+    }();
+    return res;
+}
+} // namespace
+
+BENCH(HistoryEditBufferFlush) {
+    BlockSource world;
+    auto        shape = SpanShape::sphere({0, 64, 0}, radius, false);
+    size_t      i{}, changed{};
+    for (auto _ : state) {
+        HistoryRecord record{0};
+        EditBuffer    buffer;
+        auto          blocks = pair(alternate(i));
+        shape.forEachBlock([&](BlockPos const& pos) { buffer.set(pos, blocks); });
+        changed = buffer.flush(world, &record);
+        doNotOptimize(record);
+    }
+    state.setItems(changed);
+}
+
+BENCH(HistoryFillShape) {
+    BlockSource world;
+    auto        shape = SpanShape::sphere({0, 64, 0}, radius, false);
+    size_t      i{}, changed{};
+    for (auto _ : state) {
+        HistoryRecord record{0};
+        changed = fillShape(world, shape, pair(alternate(i)), &record);
+        doNotOptimize(record);
+    }
+    state.setItems(changed);
+}
+
+BENCH(HistoryUndoRedo) {
+    BlockSource   world;
+    HistoryRecord record{0};
+    auto          shape = SpanShape::sphere({0, 64, 0}, radius, false);
+    fillShape(world, shape, pair(stone), &record);
+    for (auto _ : state) {
+        record.undo(world);
+        record.redo(world);
+    }
+    state.setItems(record.size() * 2);
+}
+
+BENCH(HistoryReplaceSubstitution) {
+    auto   region = Region::create(RegionType::Cuboid, 0, {{-64, 0, -64}, {63, 63, 63}});
+    size_t changed{};
+    for (auto _ : state) {
+        HistoryRecord record{0};
+        changed = replaceBlocks(terrain(), *region, stone, dirt, record);
+        record.undo(terrain());
+        doNotOptimize(record);
+    }
+    state.setItems(changed);
+}
+
+// A short move up, overlapping most of its own source, then its undo.
+BENCH(HistoryMoveInPlace) {
+    auto   region = Region::create(RegionType::Cuboid, 0, {{-32, 0, -32}, {31, 47, 31}});
+    size_t changed{};
+    for (auto _ : state) {
+        HistoryRecord record{0};
+        changed = moveBlocks(terrain(), *region, {0, 3, 0}, pair(*BedrockBlocks::mAir), record);
+        record.undo(terrain());
+        doNotOptimize(record);
+    }
+    state.setItems(changed);
+}
+
+BENCH(HistogramCount) {
+    auto   region = Region::create(RegionType::Cuboid, 0, {{-64, 0, -64}, {63, 63, 63}});
+    uint64 total{};
+    for (auto _ : state) {
+        auto histogram = BlockHistogram::count(terrain(), *region);
+        total          = histogram.total();
+        doNotOptimize(histogram);
+    }
+    state.setItems(total);
+}
+
+// The highest block that isn't glass of every terrain column over the full world
+// height, a fresh finder per iteration so chunks and empty sub chunks are looked
+// up again. Aborts the run unless it matches a scan down every column.
+BENCH(SurfaceFinderColumns) {
+    auto& world = terrain();
+    int   minY  = world.getMinHeight();
+    int   maxY  = world.getMaxHeight() - 1;
+    auto  solid = [](Block const& block) { return !block.isAir() && &block != &glass; };
+    std::vector<int> expected;
+    for (int x = -64; x < 64; ++x)
+        for (int z = -64; z < 64; ++z) {
+            int y = maxY;
+            while (y >= minY && !solid(world.getBlock({x, y, z}))) --y;
+            expected.push_back(y);
+        }
+
+    std::vector<int> found(expected.size());
+    for (auto _ : state) {
+        SurfaceFinder finder{
+            world,
+            minY,
+            maxY,
+            [&](BlockPos const&, Block const& block) { return solid(block); }
+        };
+        size_t i{};
+        for (int x = -64; x < 64; ++x)
+            for (int z = -64; z < 64; ++z) found[i++] = finder.getHighest(x, z);
+        doNotOptimize(found);
+    }
+    if (found != expected) {
+        std::fputs("SurfaceFinderColumns: columns differ\n", stderr);
+        std::abort();
+    }
+    state.setItems(expected.size());
+}
+
+// A gravity brush stroke: snapshot the columns around a point, drop their solid
+// runs and buffer the changes, with the columns on the heap or on the arena.
+static void columnStroke(State& state, bool arena) {
+    BoundingBox box{{-16, 32, -16}, {16, 64, 16}};
+    size_t      columns{};
+    for (auto _ : state) {
+        OperationContext operation{"stroke"};
+        ColumnSnapshot   snapshot{
+            terrain(),
+            box,
+            arena ? OperationContext::arena() : std::pmr::new_delete_resource()
+        };
+        EditBuffer buffer;
+        snapshot.transform(
+            [&](Pos2d, ColumnSnapshot::Column const& column) {
+                return compactRunsDown<BlockPair>(
+                    column,
+                    box.min.y,
+                    box.max.y,
+                    pair(*BedrockBlocks::mAir),
+                    [](BlockPair const& b) { return b.block == &glass; }
+                );
+            },
+            buffer
+        );
+        columns = snapshot.size();
+        doNotOptimize(buffer);
+    }
+    state.setItems(columns);
+}
+
+BENCH(HistoryColumnSnapshotHeap) { columnStroke(state, false); }
+
+BENCH(HistoryColumnSnapshotArena) { columnStroke(state, true); }
+
+// Every iteration sets the other biome over a sphere, recording and undoing it.
+BENCH(HistorySetBiome) {
+    static Biome const desert{"desert", 2};
+    static Biome const forest{"forest", 4};
+    auto   region = Region::create(RegionType::Sphere, 0, {{-32, 0, -32}, {31, 63, 31}});
+    size_t i{}, changed{};
+    for (auto _ : state) {
+        HistoryRecord record{0};
+        changed = setBiomes(terrain(), *region, ++i % 2 ? desert : forest, record);
+        record.undo(terrain());
+        doNotOptimize(record);
+    }
+    state.setItems(changed);
+}
+
+// The block entities of a room of chests holding one of a few loadouts, kept
+// by a record: interning stores each loadout once.
+BENCH(HistorySharedNbt) {
+    constexpr size_t         chests = 4096;
+    std::vector<std::string> loadouts;
+    for (int i = 0; i < 8; ++i) {
+        loadouts.push_back(std::string(512, (char)('a' + i)));
+    }
+    for (auto _ : state) {
+        HistoryRecord record{0};
+        for (size_t i = 0; i < chests; ++i) {
+            record.add({(int)i, 0, 0}, SharedNbt::intern(loadouts[i % loadouts.size()]));
+        }
+        doNotOptimize(record);
+    }
+    state.setItems(chests);
+}
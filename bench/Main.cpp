@@ -0,0 +1,40 @@
+#include "Bench.h"
+
+#include <cstdio>
+#include <string>
+
+using namespace we::bench;
+
+// Runs every benchmark whose name contains the first argument, growing the
+// iteration count until one run takes at least minTime.
+int main(int argc, char** argv) {
+    using namespace std::chrono;
+    constexpr auto   minTime = milliseconds(200);
+    std::string_view filter  = argc > 1 ? argv[1] : "";
+
+    std::printf("%-40s %14s %12s %16s\n", "benchmark", "ns/iter", "iterations", "items/s");
+    for (auto& benchmark : registry()) {
+        if (benchmark.name.find(filter) == std::string_view::npos) {
+            continue;
+        }
+        for (size_t iterations = 1;; iterations *= 4) {
+            State state{iterations};
+            auto  begin = steady_clock::now();
+            benchmark.fn(state);
+            auto elapsed = steady_clock::now() - begin;
+            if (elapsed < minTime && iterations < (size_t{1} << 40)) {
+                continue;
+            }
+            double ns = (double)duration_cast<nanoseconds>(elapsed).count();
+            std::printf(
+                "%-40.*s %14.1f %12zu %16.4g\n",
+                (int)benchmark.name.size(),
+                benchmark.name.data(),
+                ns / (double)iterations,
+                iterations,
+                (double)state.getItems() * (double)iterations * 1e9 / ns
+            );
+            break;
+        }
+    }
+}
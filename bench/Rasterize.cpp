@@ -0,0 +1,112 @@
+#include "Bench.h"
+#include "utils/Math.h"
+#include "utils/Rasterize.h"
+#include "utils/SparseBlockSet.h"
+
+#include <random>
+
+using namespace we;
+using namespace we::bench;
+
+namespace {
+std::vector<std::pair<BlockPos, BlockPos>> const& segments() {
+    static auto res = [] {
+        std::mt19937                       rng{42};
+        std::uniform_int_distribution<int> coord{-256, 256};
+        std::vector<std::pair<BlockPos, BlockPos>> segments(1024);
+        for (auto& [a, b] : segments) {
+            a = {coord(rng), coord(rng), coord(rng)};
+            b = {coord(rng), coord(rng), coord(rng)};
+        }
+        return segments;
+    }();
+    return res;
+}
+
+size_t totalLength() {
+    size_t res{};
+    for (auto& [a, b] : segments()) res += lineLength(a, b);
+    return res;
+}
+} // namespace
+
+BENCH(LinePlotLineVector) {
+    std::vector<BlockPos> out;
+    for (auto _ : state) {
+        out.clear();
+        for (auto& [a, b] : segments()) {
+            plotLine(a, b, [&](BlockPos const& pos) { out.push_back(pos); });
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItems(totalLength());
+}
+
+BENCH(LineRasterizeVector) {
+    std::vector<BlockPos> out;
+    for (auto _ : state) {
+        out.clear();
+        for (auto& [a, b] : segments()) {
+            rasterizeLine(a, b, out);
+        }
+        doNotOptimize(out.data());
+    }
+    state.setItems(totalLength());
+}
+
+BENCH(LinePlotLineSparseSet) {
+    for (auto _ : state) {
+        SparseBlockSet set;
+        for (auto& [a, b] : segments()) {
+            plotLine(a, b, [&](BlockPos const& pos) { set.set(pos); });
+        }
+        doNotOptimize(set);
+    }
+    state.setItems(totalLength());
+}
+
+BENCH(LineRasterizeSparseSet) {
+    for (auto _ : state) {
+        SparseBlockSet set;
+        for (auto& [a, b] : segments()) {
+            rasterizeLine(a, b, set.inserter());
+        }
+        doNotOptimize(set);
+    }
+    state.setItems(totalLength());
+}
+
+BENCH(CubicBezierVector) {
+    std::vector<BlockPos> out;
+    size_t                items{};
+    for (auto _ : state) {
+        out.clear();
+        auto& s = segments();
+        for (size_t i = 0; i + 1 < s.size(); i += 2) {
+            std::array<Vec3, 4> control{
+                s[i].first.center(),
+                s[i].second.center(),
+                s[i + 1].first.center(),
+                s[i + 1].second.center()
+            };
+            rasterizeBezier(control, out);
+        }
+        items = out.size();
+        doNotOptimize(out.data());
+    }
+    state.setItems(items);
+}
+
+BENCH(EllipseVector) {
+    std::vector<BlockPos> out;
+    size_t                items{};
+    for (auto _ : state) {
+        out.clear();
+        for (int r = 1; r <= 256; ++r) {
+            rasterizeEllipse({0, 0, 0}, r, 257 - r, 1, out);
+        }
+        items = out.size();
+        doNotOptimize(out.data());
+    }
+    state.setItems(items);
+}
@@ -0,0 +1,130 @@
+#include "Bench.h"
+#include "region/Region.h"
+
+using namespace we;
+using namespace we::bench;
+
+namespace {
+// A selection of each region type about 96 blocks across, made the way a
+// player makes it: the first point with pos1, the rest with pos2.
+std::shared_ptr<Region> makeRegion(RegionType type) {
+    std::vector<BlockPos> points;
+    switch (type) {
+    case RegionType::Cuboid:
+    case RegionType::Expand:
+        points = {
+            {-48, 0,  -48},
+            {47,  95, 47 }
+        };
+        break;
+    case RegionType::Sphere:
+        points = {
+            {0,  48, 0},
+            {48, 48, 0}
+        };
+        break;
+    case RegionType::Cylinder:
+        points = {
+            {0,  0,  0},
+            {48, 95, 0}
+        };
+        break;
+    case RegionType::Poly:
+        points = {
+            {-48, 0,  -48},
+            {48,  0,  -32},
+            {32,  95, 48 },
+            {-16, 95, 16 },
+            {-48, 95, 32 }
+        };
+        break;
+    case RegionType::Convex:
+        points = {
+            {-48, 0,  -48},
+            {48,  8,  -40},
+            {40,  0,  48 },
+            {-40, 16, 40 },
+            {0,   95, 0  },
+            {24,  60, -30}
+        };
+        break;
+    case RegionType::Loft:
+        break;
+    }
+    auto res = Region::create(type, 0, BoundingBox{points.empty() ? BlockPos{} : points[0]});
+    if (type == RegionType::Loft) {
+        // two curves of three points, lofted into a sheet
+        res->setMainPos({-48, 0, -48});
+        res->setOffPos({0, 48, -48});
+        res->setOffPos({48, 0, -48});
+        res->setMainPos({-48, 0, 48});
+        res->setOffPos({0, 95, 48});
+        res->setOffPos({48, 0, 48});
+        return res;
+    }
+    res->setMainPos(points[0]);
+    for (size_t i = 1; i < points.size(); ++i) {
+        res->setOffPos(points[i]);
+    }
+    return res;
+}
+
+// Tests every block of the bounding box, as masking and counting do.
+void benchContains(State& state, RegionType type) {
+    auto   region = makeRegion(type);
+    auto   box    = region->getBoundingBox();
+    size_t inside{};
+    for (auto _ : state) {
+        inside = 0;
+        for (int x = box.min.x; x <= box.max.x; ++x)
+            for (int z = box.min.z; z <= box.max.z; ++z)
+                for (int y = box.min.y; y <= box.max.y; ++y)
+                    inside += region->contains({x, y, z});
+        doNotOptimize(inside);
+    }
+    auto size = box.getSideLength();
+    state.setItems((size_t)size.x * size.y * size.z);
+}
+
+void benchForEach(State& state, RegionType type) {
+    auto   region = makeRegion(type);
+    size_t count{};
+    for (auto _ : state) {
+        count = 0;
+        region->forEachBlockInRegion([&](BlockPos const&) { count++; });
+        doNotOptimize(count);
+    }
+    state.setItems(count);
+}
+
+// Faces are the walls plus both caps, so they cover the walls path too.
+void benchFaces(State& state, RegionType type) {
+    auto   region = makeRegion(type);
+    size_t count{};
+    for (auto _ : state) {
+        count = 0;
+        region->forEachBlockInFaces([&](BlockPos const&) { count++; });
+        doNotOptimize(count);
+    }
+    state.setItems(count);
+}
+} // namespace
+
+BENCH(RegionCuboidContains) { benchContains(state, RegionType::Cuboid); }
+BENCH(RegionCuboidForEach) { benchForEach(state, RegionType::Cuboid); }
+BENCH(RegionCuboidFaces) { benchFaces(state, RegionType::Cuboid); }
+BENCH(RegionExpandContains) { benchContains(state, RegionType::Expand); }
+BENCH(RegionExpandForEach) { benchForEach(state, RegionType::Expand); }
+BENCH(RegionSphereContains) { benchContains(state, RegionType::Sphere); }
+BENCH(RegionSphereForEach) { benchForEach(state, RegionType::Sphere); }
+BENCH(RegionSphereFaces) { benchFaces(state, RegionType::Sphere); }
+BENCH(RegionCylinderContains) { benchContains(state, RegionType::Cylinder); }
+BENCH(RegionCylinderForEach) { benchForEach(state, RegionType::Cylinder); }
+BENCH(RegionCylinderFaces) { benchFaces(state, RegionType::Cylinder); }
+BENCH(RegionPolyContains) { benchContains(state, RegionType::Poly); }
+BENCH(RegionPolyForEach) { benchForEach(state, RegionType::Poly); }
+BENCH(RegionPolyFaces) { benchFaces(state, RegionType::Poly); }
+BENCH(RegionConvexContains) { benchContains(state, RegionType::Convex); }
+BENCH(RegionConvexForEach) { benchForEach(state, RegionType::Convex); }
+BENCH(RegionLoftContains) { benchContains(state, RegionType::Loft); }
+BENCH(RegionLoftForEach) { benchForEach(state, RegionType::Loft); }
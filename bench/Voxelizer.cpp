@@ -0,0 +1,67 @@
+#include "Bench.h"
+#include "utils/Voxelizer.h"
+
+#include <numbers>
+
+using namespace we;
+using namespace we::bench;
+
+namespace {
+// Closed uv sphere of 2 * rings * segments triangles.
+Mesh const& sphere() {
+    static auto res = [] {
+        constexpr int    rings = 700, segments = 1400;
+        constexpr double radius = 256, pi = std::numbers::pi;
+        Mesh             mesh;
+        for (int j = 0; j <= rings; ++j) {
+            for (int i = 0; i < segments; ++i) {
+                double theta = pi * j / rings, phi = 2 * pi * i / segments;
+                mesh.positions.emplace_back(
+                    (float)(radius * std::sin(theta) * std::cos(phi)),
+                    (float)(radius * std::cos(theta)),
+                    (float)(radius * std::sin(theta) * std::sin(phi))
+                );
+            }
+        }
+        auto index = [](int i, int j) { return (uint32_t)(j * segments + i % segments); };
+        for (int j = 0; j < rings; ++j) {
+            for (int i = 0; i < segments; ++i) {
+                mesh.triangles.push_back({index(i, j), index(i + 1, j), index(i + 1, j + 1)});
+                mesh.triangles.push_back({index(i, j), index(i + 1, j + 1), index(i, j + 1)});
+            }
+        }
+        return mesh;
+    }();
+    return res;
+}
+} // namespace
+
+BENCH(VoxelizerBuildBvh) {
+    for (auto _ : state) {
+        TriangleBvh bvh{sphere()};
+        doNotOptimize(bvh);
+    }
+    state.setItems(sphere().triangles.size());
+}
+
+BENCH(VoxelizerShell) {
+    TriangleBvh bvh{sphere()};
+    size_t      items{};
+    for (auto _ : state) {
+        auto result = voxelize(sphere(), bvh, false);
+        items       = result.blocks.size();
+        doNotOptimize(result);
+    }
+    state.setItems(items);
+}
+
+BENCH(VoxelizerSolid) {
+    TriangleBvh bvh{sphere()};
+    size_t      items{};
+    for (auto _ : state) {
+        auto result = voxelize(sphere(), bvh, true);
+        items       = result.blocks.size();
+        doNotOptimize(result);
+    }
+    state.setItems(items);
+}
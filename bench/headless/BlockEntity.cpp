@@ -0,0 +1,10 @@
+// Headless stand-in for src/world/BlockEntity.cpp: the in memory world has no
+// block entities to save or load.
+
+#include "world/BlockEntity.h"
+
+namespace we {
+SharedNbt saveBlockEntity(BlockSource&, BlockPos const&) { return {}; }
+
+bool loadBlockEntity(BlockSource&, BlockPos const&, SharedNbt const&) { return false; }
+} // namespace we
@@ -0,0 +1,8 @@
+// Headless stand-in for src/world/ChunkSync.cpp: the in memory world has no
+// players to send chunks to and nothing to save.
+
+#include "world/ChunkSync.h"
+
+namespace we {
+void resendChunks(BlockSource&, phmap::flat_hash_set<ChunkPos> const&) {}
+} // namespace we
@@ -0,0 +1,3 @@
+#pragma once
+
+// Included by utils/Math.h, which uses nothing from it.
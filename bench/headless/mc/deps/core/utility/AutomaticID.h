@@ -0,0 +1,10 @@
+#pragma once
+
+struct DimensionType {
+    int id{};
+
+    constexpr DimensionType() = default;
+    constexpr DimensionType(int id) : id(id) {}
+
+    constexpr operator int() const { return id; }
+};
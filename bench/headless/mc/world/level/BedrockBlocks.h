@@ -0,0 +1,9 @@
+#pragma once
+
+#include "mc/world/level/block/Block.h"
+
+namespace BedrockBlocks {
+inline Block const air{"minecraft:air"};
+
+inline Block const* mAir = &air;
+} // namespace BedrockBlocks
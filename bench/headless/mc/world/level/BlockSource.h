@@ -0,0 +1,68 @@
+#pragma once
+
+#include "mc/world/level/chunk/LevelChunk.h"
+#include "worldedit/Global.h"
+
+#include <memory>
+#include <unordered_map>
+
+// An in memory world of paletted sub chunks. A chunk is allocated, and so
+// loaded, by the first write into it; unloaded chunks read as air.
+class BlockSource {
+    short minHeight;
+    short maxHeight;
+
+    std::unordered_map<ChunkPos, std::unique_ptr<LevelChunk>> chunks;
+
+    bool inHeight(BlockPos const& pos) const { return pos.y >= minHeight && pos.y < maxHeight; }
+
+    Block const& get(BlockPos const& pos, bool extra) const {
+        auto* chunk = getChunk({pos.x >> 4, pos.z >> 4});
+        if (!chunk || !inHeight(pos)) return *BedrockBlocks::mAir;
+        return chunk->getSubChunk((short)(pos.y >> 4))
+            ->getBlock(extra, LevelChunk::storageIndex({pos, minHeight}));
+    }
+
+    bool set(BlockPos const& pos, Block const& block, bool extra) {
+        if (!inHeight(pos)) return false;
+        auto& chunk = chunks[{pos.x >> 4, pos.z >> 4}];
+        if (!chunk) {
+            chunk = std::make_unique<LevelChunk>(minHeight, maxHeight);
+        }
+        chunk->getSubChunk((short)(pos.y >> 4))
+            ->setBlock(extra, LevelChunk::storageIndex({pos, minHeight}), block);
+        return true;
+    }
+
+public:
+    explicit BlockSource(short minHeight = -64, short maxHeight = 320)
+    : minHeight(minHeight),
+      maxHeight(maxHeight) {}
+
+    short getMinHeight() const { return minHeight; }
+
+    short getMaxHeight() const { return maxHeight; }
+
+    size_t getChunkCount() const { return chunks.size(); }
+
+    LevelChunk* getChunk(ChunkPos const& pos) const {
+        auto iter = chunks.find(pos);
+        return iter == chunks.end() ? nullptr : iter->second.get();
+    }
+
+    LevelChunk* getChunkAt(BlockPos const& pos) const {
+        return getChunk({pos.x >> 4, pos.z >> 4});
+    }
+
+    Block const& getBlock(BlockPos const& pos) const { return get(pos, false); }
+
+    Block const& getExtraBlock(BlockPos const& pos) const { return get(pos, true); }
+
+    bool setBlock(BlockPos const& pos, Block const& block, int, void*, void*) {
+        return set(pos, block, false);
+    }
+
+    bool setExtraBlock(BlockPos const& pos, Block const& block, int) {
+        return set(pos, block, true);
+    }
+};
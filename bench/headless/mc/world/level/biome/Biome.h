@@ -0,0 +1,24 @@
+#pragma once
+
+#include <string>
+
+// A biome: a name and an id.
+class Biome {
+    std::string name;
+    int         id;
+
+public:
+    Biome(std::string name, int id) : name(std::move(name)), id(id) {}
+
+    Biome(Biome const&)            = delete;
+    Biome& operator=(Biome const&) = delete;
+
+    std::string const& getName() const { return name; }
+
+    int getId() const { return id; }
+};
+
+namespace headless {
+// What a chunk's biomes are until set.
+inline Biome const plains{"plains", 1};
+} // namespace headless
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "mc/world/level/block/BlockLegacy.h"
+
+#include <atomic>
+#include <string>
+
+// A block state: a name, a runtime id handed out in creation order, and
+// whether it carries a block entity.
+class Block {
+    std::string name;
+    unsigned    runtimeId;
+    BlockLegacy legacy;
+
+    static unsigned nextRuntimeId() {
+        static std::atomic<unsigned> next{};
+        return next++;
+    }
+
+public:
+    explicit Block(std::string name, bool blockEntity = false)
+    : name(std::move(name)),
+      runtimeId(nextRuntimeId()),
+      legacy(blockEntity) {}
+
+    Block(Block const&)            = delete;
+    Block& operator=(Block const&) = delete;
+
+    std::string const& getTypeName() const { return name; }
+
+    unsigned getRuntimeId() const { return runtimeId; }
+
+    bool isAir() const { return name == "minecraft:air"; }
+
+    BlockLegacy const& getLegacyBlock() const { return legacy; }
+};
@@ -0,0 +1,10 @@
+#pragma once
+
+class BlockLegacy {
+    bool blockEntity;
+
+public:
+    explicit BlockLegacy(bool blockEntity) : blockEntity(blockEntity) {}
+
+    bool hasBlockEntity() const { return blockEntity; }
+};
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "mc/world/level/biome/Biome.h"
+#include "mc/world/level/chunk/SubChunk.h"
+#include "worldedit/Global.h"
+
+#include <vector>
+
+class LevelChunk {
+    short                 minHeight;
+    std::vector<SubChunk> subChunks;
+
+public:
+    // The biomes of each sub chunk from the lowest, allocated when first set.
+    using Biomes = std::vector<std::unique_ptr<SubChunkStorage<Biome>>>;
+    std::unique_ptr<Biomes> mBiomes;
+
+    LevelChunk(short minHeight, short maxHeight)
+    : minHeight(minHeight),
+      subChunks((maxHeight - minHeight) >> 4),
+      mBiomes(std::make_unique<Biomes>(subChunks.size())) {}
+
+    short getMinSubChunkIndex() const { return (short)(minHeight >> 4); }
+
+    // index is the absolute sub chunk y, blockY >> 4.
+    SubChunk* getSubChunk(short index) {
+        index -= getMinSubChunkIndex();
+        return index >= 0 && index < (short)subChunks.size() ? &subChunks[index] : nullptr;
+    }
+    SubChunk const* getSubChunk(short index) const {
+        return const_cast<LevelChunk*>(this)->getSubChunk(index);
+    }
+
+    Block const& getBlock(ChunkBlockPos const& pos) const {
+        return subChunks[pos.y >> 4].getBlock(false, storageIndex(pos));
+    }
+
+    Block const& getExtraBlock(ChunkBlockPos const& pos) const {
+        return subChunks[pos.y >> 4].getBlock(true, storageIndex(pos));
+    }
+
+    Biome const& getBiome(ChunkBlockPos const& pos) const {
+        auto& layer = (*mBiomes)[pos.y >> 4];
+        return layer ? layer->getElement(storageIndex(pos)) : headless::plains;
+    }
+
+    void _setBiome(Biome const& biome, ChunkBlockPos const& pos, bool) {
+        auto& layer = (*mBiomes)[pos.y >> 4];
+        if (!layer) {
+            layer = std::make_unique<SubChunkStorage<Biome>>(headless::plains);
+        }
+        layer->setElement(storageIndex(pos), biome);
+    }
+
+    static unsigned short storageIndex(ChunkBlockPos const& pos) {
+        return (unsigned short)(pos.x << 8 | pos.z << 4 | (pos.y & 15));
+    }
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "mc/world/level/chunk/SubChunkStorage.h"
+
+#include <memory>
+
+// Layer 0 holds the blocks, layer 1 the liquids; a layer is allocated when
+// first written.
+struct SubChunk {
+    std::unique_ptr<std::array<std::unique_ptr<SubChunkStorage<Block>>, 2>> mBlocks =
+        std::make_unique<std::array<std::unique_ptr<SubChunkStorage<Block>>, 2>>();
+
+    Block const& getBlock(bool extra, unsigned short index) const {
+        auto& layer = (*mBlocks)[extra];
+        return layer ? layer->getElement(index) : *BedrockBlocks::mAir;
+    }
+
+    void setBlock(bool extra, unsigned short index, Block const& block) {
+        auto& layer = (*mBlocks)[extra];
+        if (!layer) {
+            if (&block == BedrockBlocks::mAir) return;
+            layer = std::make_unique<SubChunkStorage<Block>>(*BedrockBlocks::mAir);
+        }
+        layer->setElement(index, block);
+    }
+};
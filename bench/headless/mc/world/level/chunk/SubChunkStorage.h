@@ -0,0 +1,36 @@
+#pragma once
+
+#include "mc/world/level/BedrockBlocks.h"
+
+#include <array>
+#include <vector>
+
+// Paletted 16x16x16 storage of blocks or biomes, indexed x major, then z, then y.
+template <class T>
+class SubChunkStorage {
+    std::vector<T const*>            palette;
+    std::array<unsigned short, 4096> indices{};
+
+public:
+    explicit SubChunkStorage(T const& initial) : palette{&initial} {}
+
+    T const& getElement(unsigned short index) const { return *palette[indices[index]]; }
+
+    // False when the palette is full, as the server's fixed width storages are.
+    bool setElement(unsigned short index, T const& element) {
+        unsigned short id = 0;
+        while (id < palette.size() && palette[id] != &element) ++id;
+        if (id == palette.size()) {
+            palette.push_back(&element);
+        }
+        indices[index] = id;
+        return true;
+    }
+
+    bool isUniform(T const& element) const {
+        for (auto i : indices) {
+            if (palette[i] != &element) return false;
+        }
+        return true;
+    }
+};
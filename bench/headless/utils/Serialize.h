@@ -0,0 +1,4 @@
+#pragma once
+
+// Serialization is a no-op headless, see worldedit/Global.h.
+#include "worldedit/Global.h"
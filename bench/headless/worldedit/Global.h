@@ -0,0 +1,457 @@
+#pragma once
+
+// Headless stand-in for the server headers src/worldedit/Global.h pulls in:
+// just enough of their types for the engine code the benchmarks build, so they
+// build and run anywhere, not only next to a server.
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "mc/deps/core/utility/AutomaticID.h"
+#include "utils/InplaceVector.h"
+#include "utils/WithDim.h"
+
+using uchar  = unsigned char;
+using schar  = signed char;
+using ushort = unsigned short;
+using uint   = unsigned int;
+using int64  = int64_t;
+using uint64 = uint64_t;
+
+namespace phmap {
+template <class T>
+using Hash = std::hash<T>;
+template <class T>
+using EqualTo = std::equal_to<T>;
+template <
+    class K,
+    class V,
+    class Hash  = std::hash<K>,
+    class Eq    = std::equal_to<K>,
+    class Alloc = std::allocator<std::pair<K const, V>>>
+using flat_hash_map = std::unordered_map<K, V, Hash, Eq, Alloc>;
+template <class K, class Hash = std::hash<K>, class Eq = std::equal_to<K>>
+using flat_hash_set = std::unordered_set<K, Hash, Eq>;
+} // namespace phmap
+
+template <class T>
+class optional_ref {
+    T* ptr{};
+
+public:
+    optional_ref() = default;
+    optional_ref(std::nullptr_t) {}
+    optional_ref(T& ref) : ptr(&ref) {}
+    optional_ref(T* ptr) : ptr(ptr) {}
+
+    explicit operator bool() const { return ptr != nullptr; }
+    T*       operator->() const { return ptr; }
+    T&       operator*() const { return *ptr; }
+    T*       as_ptr() const { return ptr; }
+};
+
+// What utils/Hash.h does for phmap: types with a hash_value get a std::hash.
+template <class T>
+    requires requires(T const& v) {
+        { hash_value(v) } -> std::convertible_to<size_t>;
+    }
+struct std::hash<T> {
+    size_t operator()(T const& v) const { return hash_value(v); }
+};
+
+namespace ll {
+struct Error {
+    std::string message;
+};
+
+// std::expected<T, Error> with the monadic operations the engine chains, which
+// not every standard library ships yet.
+template <class T = void>
+class Expected : public std::expected<T, Error> {
+    using Base = std::expected<T, Error>;
+
+public:
+    using Base::Base;
+
+    Expected(Base&& base) : Base(std::move(base)) {}
+
+    template <class F>
+    auto and_then(F&& f) const {
+        using R = std::remove_cvref_t<decltype(call(f))>;
+        if (!this->has_value()) return R{std::unexpected(this->error())};
+        return call(f);
+    }
+
+    template <class F>
+    auto transform(F&& f) const {
+        using U = std::remove_cvref_t<decltype(call(f))>;
+        if (!this->has_value()) return Expected<U>{std::unexpected(this->error())};
+        return Expected<U>{call(f)};
+    }
+
+private:
+    template <class F>
+    decltype(auto) call(F& f) const {
+        if constexpr (std::is_void_v<T>) {
+            return f();
+        } else {
+            return f(**this);
+        }
+    }
+};
+
+inline std::unexpected<Error> forwardError(Error error) {
+    return std::unexpected(std::move(error));
+}
+
+namespace math {
+struct longlong3 {
+    long long x{}, y{}, z{};
+
+    constexpr longlong3(long long v = 0) : x(v), y(v), z(v) {}
+    constexpr longlong3(long long x, long long y, long long z) : x(x), y(y), z(z) {}
+};
+} // namespace math
+} // namespace ll
+
+struct BlockPos;
+
+struct Vec3 {
+    float x{}, y{}, z{};
+
+    constexpr Vec3() = default;
+    template <class X, class Y, class Z>
+        requires(std::is_arithmetic_v<X> && std::is_arithmetic_v<Y> && std::is_arithmetic_v<Z>)
+    constexpr Vec3(X x, Y y, Z z)
+    : x((float)x),
+      y((float)y),
+      z((float)z) {}
+    explicit constexpr Vec3(ll::math::longlong3 const& v)
+    : x((float)v.x),
+      y((float)v.y),
+      z((float)v.z) {}
+    constexpr Vec3(BlockPos const&);
+
+    Vec3 operator+(Vec3 const& o) const { return {x + o.x, y + o.y, z + o.z}; }
+    Vec3 operator-(Vec3 const& o) const { return {x - o.x, y - o.y, z - o.z}; }
+    Vec3 operator*(Vec3 const& o) const { return {x * o.x, y * o.y, z * o.z}; }
+    Vec3 operator+(double o) const { return {x + o, y + o, z + o}; }
+    Vec3 operator-(double o) const { return {x - o, y - o, z - o}; }
+    Vec3 operator*(double o) const { return {x * o, y * o, z * o}; }
+    Vec3 operator/(double o) const { return {x / o, y / o, z / o}; }
+    Vec3 operator-() const { return {-x, -y, -z}; }
+
+    Vec3& operator+=(Vec3 const& o) { return *this = *this + o; }
+    Vec3& operator-=(Vec3 const& o) { return *this = *this - o; }
+    Vec3& operator*=(double o) { return *this = *this * o; }
+
+    bool operator==(Vec3 const&) const = default;
+
+    float dot(Vec3 const& o) const { return x * o.x + y * o.y + z * o.z; }
+    Vec3  cross(Vec3 const& o) const {
+        return {y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x};
+    }
+    float lengthSqr() const { return dot(*this); }
+    float length() const { return std::sqrt(lengthSqr()); }
+    float distanceTo(Vec3 const& o) const { return (*this - o).length(); }
+    Vec3  normalize() const {
+        auto l = length();
+        return l == 0 ? *this : *this / l;
+    }
+    Vec3 floor() const { return {std::floor(x), std::floor(y), std::floor(z)}; }
+};
+
+inline Vec3 operator*(double s, Vec3 const& v) { return v * s; }
+
+struct BlockPos {
+    int x{}, y{}, z{};
+
+    constexpr BlockPos() = default;
+    constexpr BlockPos(int x, int y, int z) : x(x), y(y), z(z) {}
+    constexpr BlockPos(int v) : x(v), y(v), z(v) {}
+    constexpr BlockPos(Vec3 const& v)
+    : x((int)std::floor(v.x)),
+      y((int)std::floor(v.y)),
+      z((int)std::floor(v.z)) {}
+
+    constexpr BlockPos operator+(BlockPos const& o) const { return {x + o.x, y + o.y, z + o.z}; }
+    constexpr BlockPos operator-(BlockPos const& o) const { return {x - o.x, y - o.y, z - o.z}; }
+    constexpr BlockPos operator*(BlockPos const& o) const { return {x * o.x, y * o.y, z * o.z}; }
+    constexpr BlockPos operator+(int o) const { return {x + o, y + o, z + o}; }
+    constexpr BlockPos operator-(int o) const { return {x - o, y - o, z - o}; }
+    constexpr BlockPos operator*(int o) const { return {x * o, y * o, z * o}; }
+    constexpr BlockPos operator/(int o) const { return {x / o, y / o, z / o}; }
+    constexpr BlockPos operator-() const { return {-x, -y, -z}; }
+
+    BlockPos& operator+=(BlockPos const& o) { return *this = *this + o; }
+    BlockPos& operator-=(BlockPos const& o) { return *this = *this - o; }
+
+    constexpr bool operator==(BlockPos const&) const = default;
+    constexpr auto operator<=>(BlockPos const&) const = default;
+
+    int& operator[](size_t i) { return i == 0 ? x : i == 1 ? y : z; }
+    int  operator[](size_t i) const { return i == 0 ? x : i == 1 ? y : z; }
+
+    Vec3 center() const { return {x + 0.5f, y + 0.5f, z + 0.5f}; }
+    Vec3 bottomCenter() const { return {x + 0.5f, (float)y, z + 0.5f}; }
+
+    int64 dot(BlockPos const& o) const {
+        return (int64)x * o.x + (int64)y * o.y + (int64)z * o.z;
+    }
+    BlockPos cross(BlockPos const& o) const {
+        return {y * o.z - z * o.y, z * o.x - x * o.z, x * o.y - y * o.x};
+    }
+    float length() const { return Vec3{*this}.length(); }
+    float distanceTo(BlockPos const& o) const { return (*this - o).length(); }
+
+    std::array<BlockPos, 6> getNeighbors() const {
+        return {
+            BlockPos{x, y - 1, z},
+            BlockPos{x, y + 1, z},
+            BlockPos{x, y, z - 1},
+            BlockPos{x, y, z + 1},
+            BlockPos{x - 1, y, z},
+            BlockPos{x + 1, y, z},
+        };
+    }
+};
+
+constexpr Vec3::Vec3(BlockPos const& p) : x((float)p.x), y((float)p.y), z((float)p.z) {}
+
+inline Vec3 operator+(Vec3 const& v, BlockPos const& p) { return v + Vec3{p}; }
+inline Vec3 operator-(Vec3 const& v, BlockPos const& p) { return v - Vec3{p}; }
+
+template <>
+struct std::hash<BlockPos> {
+    size_t operator()(BlockPos const& p) const {
+        return ((uint64)(uint)p.x * 0x9E3779B97F4A7C15ull) ^ ((uint64)(uint)p.y << 40)
+             ^ ((uint64)(uint)p.z * 0xC2B2AE3D27D4EB4Full);
+    }
+};
+
+namespace ll::math {
+inline longlong3 operator+(longlong3 const& a, BlockPos const& b) {
+    return {a.x + b.x, a.y + b.y, a.z + b.z};
+}
+inline longlong3 operator-(longlong3 const& a, BlockPos const& b) {
+    return {a.x - b.x, a.y - b.y, a.z - b.z};
+}
+inline longlong3 operator/(longlong3 const& a, long long b) { return {a.x / b, a.y / b, a.z / b}; }
+inline longlong3& operator+=(longlong3& a, BlockPos const& b) {
+    a.x += b.x;
+    a.y += b.y;
+    a.z += b.z;
+    return a;
+}
+inline longlong3& operator-=(longlong3& a, BlockPos const& b) {
+    a.x -= b.x;
+    a.y -= b.y;
+    a.z -= b.z;
+    return a;
+}
+} // namespace ll::math
+
+struct Vec2 {
+    float x{}, z{};
+};
+
+struct Pos2d {
+    int x{}, z{};
+
+    constexpr Pos2d() = default;
+    constexpr Pos2d(int x, int z) : x(x), z(z) {}
+    constexpr Pos2d(BlockPos const& pos) : x(pos.x), z(pos.z) {}
+
+    constexpr Pos2d operator+(Pos2d const& o) const { return {x + o.x, z + o.z}; }
+    constexpr Pos2d operator-(Pos2d const& o) const { return {x - o.x, z - o.z}; }
+    constexpr Pos2d operator*(int o) const { return {x * o, z * o}; }
+    constexpr Pos2d operator/(int o) const { return {x / o, z / o}; }
+
+    constexpr bool operator==(Pos2d const&) const = default;
+
+    float distanceTo(Pos2d const& o) const {
+        return std::hypot((float)(x - o.x), (float)(z - o.z));
+    }
+};
+
+struct ChunkPos {
+    int x{}, z{};
+
+    bool operator==(ChunkPos const&) const = default;
+};
+
+template <>
+struct std::hash<ChunkPos> {
+    size_t operator()(ChunkPos const& p) const { return (uint64)(uint)p.x << 32 | (uint)p.z; }
+};
+
+struct SubChunkPos {
+    int x{}, y{}, z{};
+
+    bool operator==(SubChunkPos const&) const = default;
+};
+
+struct ChunkBlockPos {
+    uchar x, z;
+    short y;
+
+    ChunkBlockPos(BlockPos const& pos, short minHeight)
+    : x((uchar)(pos.x & 15)),
+      z((uchar)(pos.z & 15)),
+      y((short)(pos.y - minHeight)) {}
+};
+
+struct BoundingBox {
+    BlockPos min;
+    BlockPos max;
+
+    constexpr BoundingBox() = default;
+    constexpr BoundingBox(BlockPos const& pos) : min(pos), max(pos) {}
+    constexpr BoundingBox(BlockPos const& min, BlockPos const& max) : min(min), max(max) {}
+
+    bool contains(BlockPos const& p) const {
+        return p.x >= min.x && p.x <= max.x && p.y >= min.y && p.y <= max.y && p.z >= min.z
+            && p.z <= max.z;
+    }
+
+    BlockPos getSideLength() const { return max - min + 1; }
+
+    BoundingBox merge(BoundingBox const& o) const {
+        return {
+            {std::min(min.x, o.min.x), std::min(min.y, o.min.y), std::min(min.z, o.min.z)},
+            {std::max(max.x, o.max.x), std::max(max.y, o.max.y), std::max(max.z, o.max.z)}
+        };
+    }
+
+    BlockPos center() const { return (min + max) / 2; }
+
+    std::vector<BlockPos> forEachPos() const {
+        std::vector<BlockPos> res;
+        for (int y = min.y; y <= max.y; ++y)
+            for (int z = min.z; z <= max.z; ++z)
+                for (int x = min.x; x <= max.x; ++x) res.emplace_back(x, y, z);
+        return res;
+    }
+};
+
+struct AABB {
+    Vec3 min;
+    Vec3 max;
+
+    AABB(Vec3 const& min, Vec3 const& max) : min(min), max(max) {}
+    AABB(BoundingBox const& box) : min(box.min), max(Vec3{box.max} + 1.0) {}
+
+    Vec3 center() const { return (min + max) * 0.5; }
+};
+
+namespace mce {
+struct Color {
+    float r{}, g{}, b{}, a{1};
+
+    Color() = default;
+    Color(float r, float g, float b, float a = 1) : r(r), g(g), b(b), a(a) {}
+    Color(std::string_view) {}
+};
+} // namespace mce
+
+// Tags are accepted and ignored; the benchmarks never save regions.
+class CompoundTag;
+class CompoundTagVariant {
+public:
+    template <class T>
+    std::vector<CompoundTagVariant> const& get() const {
+        static std::vector<CompoundTagVariant> empty;
+        return empty;
+    }
+    CompoundTagVariant const& operator[](std::string_view) const { return *this; }
+    CompoundTagVariant&       operator[](std::string_view) { return *this; }
+    CompoundTagVariant const& at(std::string_view) const { return *this; }
+};
+class ListTag {};
+class CompoundTag : public CompoundTagVariant {};
+
+namespace ll::reflection {
+template <class J, class T>
+inline Expected<> serialize_to(J&, T const&) {
+    return {};
+}
+template <class T, class J>
+inline Expected<> deserialize(T&, J const&) {
+    return {};
+}
+template <class T, class J>
+inline Expected<T> deserialize_to(J const&) {
+    return T{};
+}
+} // namespace ll::reflection
+
+// Geometry is drawn for players; headless it goes nowhere.
+namespace bsci {
+class GeometryGroup {
+public:
+    struct GeoId {
+        uint64 value;
+    };
+
+    using Color     = mce::Color;
+    using Thickness = std::optional<float>;
+
+    GeoId box(DimensionType, BoundingBox const&, Color const&, Thickness = {}) { return {0}; }
+    GeoId line(DimensionType, Vec3 const&, Vec3 const&, Color const&, Thickness = {}) {
+        return {0};
+    }
+    GeoId line(DimensionType, std::span<Vec3 const>, Color const&, Thickness = {}) {
+        return {0};
+    }
+    GeoId sphere(DimensionType, Vec3 const&, float, Color const&, Thickness = {}) {
+        return {0};
+    }
+    GeoId cylinder(DimensionType, Vec3 const&, Vec3 const&, float, Color const&, Thickness = {}) {
+        return {0};
+    }
+    GeoId merge(std::span<GeoId const>) { return {0}; }
+    bool  shift(GeoId, Vec3 const&) { return true; }
+    bool  remove(GeoId) { return true; }
+};
+} // namespace bsci
+
+class BlockSource;
+
+class Dimension {
+public:
+    BlockSource& getBlockSourceFromMainChunkSource();
+};
+
+class Level {
+public:
+    std::weak_ptr<Dimension> getDimension(DimensionType) { return {}; }
+};
+
+// There is no level; benchmarks construct their BlockSource directly.
+namespace ll::service {
+inline optional_ref<Level> getLevel() { return nullptr; }
+} // namespace ll::service
+
+#include "mc/world/level/BlockSource.h"
+
+namespace we {
+class WorldEdit;
+}
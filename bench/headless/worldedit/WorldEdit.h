@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Global.h"
+
+namespace we {
+// The mod singleton, reduced to the geometry and colours regions draw with.
+class WorldEdit {
+public:
+    struct Config {
+        struct {
+            mce::Color region_line_color{"#FFEC27"};
+            mce::Color region_point_color{"#10E436"};
+            mce::Color region_point_color2{"#94FFD8"};
+        } colors;
+    };
+
+private:
+    bsci::GeometryGroup geo;
+    Config              config;
+
+public:
+    static WorldEdit& getInstance() {
+        static WorldEdit instance;
+        return instance;
+    }
+
+    [[nodiscard]] bsci::GeometryGroup& getGeo() { return geo; }
+
+    [[nodiscard]] Config& getConfig() { return config; }
+};
+} // namespace we
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "world/EditBuffer.h"
+#include "worldedit/Global.h"
+
+namespace we {
+class Brush {
+protected:
+    int       radius;
+    BlockPair blocks;
+
+public:
+    Brush(int radius, BlockPair const& blocks) : radius(radius), blocks(blocks) {}
+
+    virtual ~Brush() = default;
+
+    int getRadius() const { return radius; }
+
+    // The area one application at center may write.
+    virtual BoundingBox getBox(BlockSource&, BlockPos const& center) const {
+        return {center - radius, center + radius};
+    }
+
+    // Positions one application at center may change.
+    virtual void
+    forEachBlock(BlockPos const& center, std::function<void(BlockPos const&)>&&) const = 0;
+
+    // What pos becomes, nullopt keeps it.
+    // Within a stroke every position is evaluated at most once.
+    virtual std::optional<BlockPair> evaluate(BlockSource&, BlockPos const&) const {
+        return blocks;
+    }
+
+    // Brushes reading blocks they wrote themselves (like smoothing) can't be
+    // merged, their applications are painted and written one by one.
+    virtual bool isCoalescible() const { return true; }
+
+    // Writes of one application that isn't merged into a stroke.
+    virtual void paint(BlockSource& blockSource, BlockPos const& center, EditBuffer& out)
+        const {
+        forEachBlock(center, [&](BlockPos const& pos) {
+            if (auto res = evaluate(blockSource, pos); res) {
+                out.set(pos, *res);
+            }
+        });
+    }
+};
+} // namespace we
@@ -0,0 +1,88 @@
+#include "BrushStroke.h"
+#include "worldedit/WorldEdit.h"
+
+namespace we {
+BrushStroke::BrushStroke(
+    mce::UUID const&             owner,
+    std::shared_ptr<Brush const> brush,
+    DimensionType                dim,
+    uint64                       tick
+)
+: owner(owner),
+  brush(std::move(brush)),
+  dim(dim),
+  record(std::make_shared<HistoryRecord>(dim)),
+  lastTick(tick) {}
+
+bool BrushStroke::canContinue(
+    Brush const&  other,
+    DimensionType otherDim,
+    uint64        tick,
+    uint64        idleTicks
+) const {
+    return brush.get() == &other && dim == otherDim && tick - lastTick <= idleTicks;
+}
+
+void BrushStroke::apply(BlockPos const& center, uint64 tick) {
+    auto blockSource = getBlockSource(dim);
+    if (!blockSource) {
+        return;
+    }
+    // dropped over a running edit, holding the brush applies it again later
+    auto box = brush->getBox(*blockSource, center);
+    if (WorldEdit::getInstance().getScheduler().isLocked(dim, box)) {
+        return;
+    }
+    lastTick = tick;
+    if (!brush->isCoalescible()) {
+        brush->paint(*blockSource, center, pending);
+        flush();
+        return;
+    }
+    brush->forEachBlock(center, [&](BlockPos const& pos) {
+        if (!evaluated.insert(pos).second) {
+            return;
+        }
+        if (auto blocks = brush->evaluate(*blockSource, pos); blocks) {
+            pending.set(pos, *blocks);
+        }
+    });
+    if (!flushScheduled && !pending.empty()) {
+        flushScheduled = true;
+        ll::thread::ServerThreadExecutor::getDefault().executeAfter(
+            [self = shared_from_this()] { self->flushDeferred(); },
+            1_tick
+        );
+    }
+}
+
+size_t BrushStroke::flush() {
+    flushScheduled = false;
+    if (pending.empty()) {
+        return 0;
+    }
+    auto blockSource = getBlockSource(dim);
+    if (!blockSource) {
+        pending.clear();
+        return 0;
+    }
+    return pending.flush(*blockSource, record.get());
+}
+
+void BrushStroke::flushDeferred() {
+    auto&                we   = WorldEdit::getInstance();
+    auto                 lctx = we.getLocalContextManager().get(owner);
+    MemoryAccount::Scope account{lctx ? lctx->memory : nullptr};
+    OperationContext     operation{"brush"};
+    flush();
+    auto stats = operation.finish();
+    if (stats.empty()) {
+        return;
+    }
+    if (lctx) {
+        lctx->recordOperation(std::move(stats));
+    } else {
+        we.recordOperation(stats);
+    }
+}
+} // namespace we
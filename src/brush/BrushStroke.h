@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Brush.h"
+#include "data/History.h"
+
+#include <mc/platform/UUID.h>
+
+namespace we {
+// Merges the applications of one brush by one player into a single edit.
+// Positions are evaluated once per stroke, pending writes are flushed at most
+// once per tick, and the whole stroke shares one history record.
+class BrushStroke : public std::enable_shared_from_this<BrushStroke> {
+    mce::UUID                      owner;
+    std::shared_ptr<Brush const>   brush;
+    DimensionType                  dim;
+    std::shared_ptr<HistoryRecord> record;
+    phmap::flat_hash_set<BlockPos> evaluated;
+    EditBuffer                     pending;
+    uint64                         lastTick;
+    bool                           flushScheduled{};
+
+public:
+    BrushStroke(
+        mce::UUID const&             owner,
+        std::shared_ptr<Brush const> brush,
+        DimensionType                dim,
+        uint64                       tick
+    );
+
+    // Whether an application at tick continues this stroke.
+    bool canContinue(Brush const&, DimensionType, uint64 tick, uint64 idleTicks) const;
+
+    std::shared_ptr<HistoryRecord> const& getRecord() const { return record; }
+
+    void apply(BlockPos const& center, uint64 tick);
+
+    size_t flush();
+
+private:
+    // The flush a tick after coalesced applications, an operation of the owner.
+    void flushDeferred();
+};
+} // namespace we
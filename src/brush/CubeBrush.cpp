@@ -0,0 +1,11 @@
+#include "CubeBrush.h"
+#include "utils/Spans.h"
+
+namespace we {
+void CubeBrush::forEachBlock(
+    BlockPos const&                        center,
+    std::function<void(BlockPos const&)>&& todo
+) const {
+    SpanShape::cube(center, radius, false).forEachBlock(todo);
+}
+} // namespace we
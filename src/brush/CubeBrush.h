@@ -0,0 +1,13 @@
+#pragma once
+
+#include "Brush.h"
+
+namespace we {
+class CubeBrush : public Brush {
+public:
+    using Brush::Brush;
+
+    void forEachBlock(BlockPos const& center, std::function<void(BlockPos const&)>&&)
+        const override;
+};
+} // namespace we
@@ -0,0 +1,46 @@
+#include "GravityBrush.h"
+#include "world/ColumnSnapshot.h"
+
+#include <mc/world/level/BedrockBlocks.h>
+#include <mc/world/level/block/Block.h>
+
+namespace we {
+GravityBrush::GravityBrush(int radius, bool fullHeight)
+: Brush(radius, {BedrockBlocks::mAir, BedrockBlocks::mAir}),
+  fullHeight(fullHeight) {}
+
+BoundingBox GravityBrush::getBox(BlockSource& blockSource, BlockPos const& center) const {
+    BoundingBox box{center - radius, center + radius};
+    if (fullHeight) {
+        box.max.y = blockSource.getMaxHeight() - 1;
+    }
+    return box;
+}
+
+void GravityBrush::forEachBlock(
+    BlockPos const&                        center,
+    std::function<void(BlockPos const&)>&& todo
+) const {
+    for (auto&& pos : BoundingBox{center - radius, center + radius}.forEachPos()) {
+        todo(pos);
+    }
+}
+
+void GravityBrush::paint(BlockSource& blockSource, BlockPos const& center, EditBuffer& out)
+    const {
+    ColumnSnapshot snapshot{blockSource, getBox(blockSource, center)};
+    auto&          box = snapshot.getBoundingBox();
+    snapshot.transform(
+        [&](Pos2d, ColumnSnapshot::Column const& column) {
+            return compactRunsDown<BlockPair>(
+                column,
+                box.min.y,
+                box.max.y,
+                blocks,
+                [](BlockPair const& b) { return b.block->isAir(); }
+            );
+        },
+        out
+    );
+}
+} // namespace we
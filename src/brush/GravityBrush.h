@@ -0,0 +1,22 @@
+#pragma once
+
+#include "Brush.h"
+
+namespace we {
+// Lets the blocks of every column in the brush box fall to its bottom.
+class GravityBrush : public Brush {
+    bool fullHeight;
+
+public:
+    GravityBrush(int radius, bool fullHeight);
+
+    BoundingBox getBox(BlockSource&, BlockPos const& center) const override;
+
+    void forEachBlock(BlockPos const& center, std::function<void(BlockPos const&)>&&)
+        const override;
+
+    void paint(BlockSource&, BlockPos const& center, EditBuffer&) const override;
+
+    bool isCoalescible() const override { return false; }
+};
+} // namespace we
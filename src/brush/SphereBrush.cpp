@@ -0,0 +1,11 @@
+#include "SphereBrush.h"
+#include "utils/Spans.h"
+
+namespace we {
+void SphereBrush::forEachBlock(
+    BlockPos const&                        center,
+    std::function<void(BlockPos const&)>&& todo
+) const {
+    SpanShape::sphere(center, radius, false).forEachBlock(todo);
+}
+} // namespace we
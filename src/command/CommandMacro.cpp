@@ -2,6 +2,8 @@
 #include "Command.h"
 #include "utils/FacingUtils.h"
 
+#include <mc/world/actor/player/Player.h>
+
 namespace we {
 auto& setupCommandFunctions() {
     static ll::OrderedMap<std::string, std::function<void()>> ins;
@@ -63,8 +65,95 @@ std::shared_ptr<Region> checkRegion(CommandContextRef const& ctx) {
         ctx.error("origin didn't selected any region");
         return nullptr;
     }
+    if (lctx->isRegionInUse()) {
+        ctx.error("region is in use until your running edit finishes");
+        return nullptr;
+    }
     return lctx->region;
 }
+void sendPlayerMessage(mce::UUID const& uuid, std::string const& msg) {
+    auto level = ll::service::getLevel();
+    if (!level) {
+        return;
+    }
+    if (auto player = level->getPlayer(uuid); player) {
+        player->sendMessage(msg);
+    }
+}
+void finishOperation(CommandContextRef const& ctx, OperationContext const& operation) {
+    auto stats = operation.finish();
+    if (stats.empty()) {
+        return;
+    }
+    auto& we = WorldEdit::getInstance();
+    if (auto lctx = we.getLocalContextManager().get(ctx.origin)) {
+        lctx->recordOperation(std::move(stats));
+    } else {
+        we.recordOperation(stats);
+    }
+}
+std::shared_ptr<MemoryAccount> getMemoryAccount(CommandContextRef const& ctx) {
+    if (auto lctx = WorldEdit::getInstance().getLocalContextManager().get(ctx.origin)) {
+        return lctx->memory;
+    }
+    return nullptr;
+}
+bool checkUnlocked(CommandContextRef const& ctx, DimensionType dim, BoundingBox const& area) {
+    if (WorldEdit::getInstance().getScheduler().isLocked(dim, area)) {
+        ctx.error("area is locked by a running edit, try again once it finishes");
+        return false;
+    }
+    return true;
+}
+// The limits checkMemory applies, telling fail(fmt, args...) the first broken.
+template <class Fail>
+static bool checkMemoryLimits(size_t bytes, Fail&& fail) {
+    constexpr size_t mib    = 1 << 20;
+    auto&            config = WorldEdit::getInstance().getConfig().memory;
+    if (bytes > config.operation_limit_mb * mib) {
+        fail(
+            "this edit needs about {0} MiB, over the limit of {1} MiB",
+            bytes / mib,
+            config.operation_limit_mb
+        );
+        return false;
+    }
+    if (auto& account = MemoryAccount::current();
+        account && (size_t)account->total() + bytes > config.player_limit_mb * mib) {
+        fail(
+            "your edits already hold {0} MiB, this one would pass the limit of {1} MiB",
+            account->total() / mib,
+            config.player_limit_mb
+        );
+        return false;
+    }
+    if ((size_t)MemoryAccount::server().total() + bytes > config.server_limit_mb * mib) {
+        fail(
+            "edits on the server already hold {0} MiB, this one would pass the limit "
+            "of {1} MiB",
+            MemoryAccount::server().total() / mib,
+            config.server_limit_mb
+        );
+        return false;
+    }
+    return true;
+}
+bool checkMemory(CommandContextRef const& ctx, size_t bytes) {
+    return checkMemoryLimits(
+        bytes,
+        [&]<class... Args>(fmt::format_string<Args...> fmt, Args&&... args) {
+            ctx.error(fmt, std::forward<Args>(args)...);
+        }
+    );
+}
+bool checkMemory(mce::UUID const& owner, size_t bytes) {
+    return checkMemoryLimits(
+        bytes,
+        [&]<class... Args>(fmt::format_string<Args...> fmt, Args&&... args) {
+            notifyPlayer(owner, fmt, std::forward<Args>(args)...);
+        }
+    );
+}
 std::optional<FacingID> checkFacing(CommandFacing facing, CommandContextRef const& ctx) {
     if (facing == CommandFacing::Me) {
         auto player = checkPlayer(ctx);
@@ -75,6 +75,29 @@ public:
     }
 };
 
+// Sends msg to the player of uuid, if online.
+void sendPlayerMessage(mce::UUID const& uuid, std::string const& msg);
+
+// Tells the player of uuid, if online, the way CommandContextRef::success does;
+// for scheduled edits finishing after their command returned.
+template <class... Args>
+void notifyPlayer(mce::UUID const& uuid, fmt::format_string<Args...> fmt, Args&&... args) {
+    auto fsv = fmt.get();
+    sendPlayerMessage(
+        uuid,
+        fmt::vformat(
+            ll::i18n::getInstance().get({fsv.data(), fsv.size()}, {}),
+            fmt::make_format_args(args...)
+        )
+    );
+}
+
+// Records the stats of a command's operation, unless it touched nothing.
+void finishOperation(CommandContextRef const&, OperationContext const&);
+
+// The account of the origin's player, null for other origins.
+std::shared_ptr<MemoryAccount> getMemoryAccount(CommandContextRef const&);
+
 class CmdCtxBuilder {
 public:
     template <class Fn>
@@ -89,7 +112,9 @@ public:
                    CommandOutput&       output,
                    auto&                param,
                    ::Command const&     cmd) {
-            CommandContextRef ctxref{origin, output, cmd};
+            CommandContextRef    ctxref{origin, output, cmd};
+            MemoryAccount::Scope account{getMemoryAccount(ctxref)};
+            OperationContext     operation{cmd.getCommandName()};
             if constexpr (std::is_invocable_v<
                               Fn,
                               CommandContextRef const&,
@@ -102,6 +127,7 @@ public:
             } else {
                 static_assert(false);
             }
+            finishOperation(ctxref, operation);
         };
     }
 };
@@ -134,6 +160,15 @@ std::shared_ptr<LocalContext> checkLocalContext(CommandContextRef const& ctx);
 std::shared_ptr<LocalContext> getLocalContext(CommandContextRef const& ctx);
 std::optional<FacingID>       checkFacing(CommandFacing, CommandContextRef const& ctx);
 
+// Refuses an edit of area while a scheduled edit locks chunks of it.
+bool checkUnlocked(CommandContextRef const& ctx, DimensionType, BoundingBox const& area);
+
+// Refuses an edit estimated to need bytes more, if that breaks Config::memory.
+bool checkMemory(CommandContextRef const& ctx, size_t bytes);
+
+// The same for an edit sized after its command returned, telling owner why.
+bool checkMemory(mce::UUID const& owner, size_t bytes);
+
 } // namespace we
 
 template <we::IsVaArg T>
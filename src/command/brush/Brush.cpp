@@ -0,0 +1,117 @@
+#include "brush/CubeBrush.h"
+#include "brush/GravityBrush.h"
+#include "brush/SphereBrush.h"
+#include "command/CommandMacro.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+REG_CMD(brush, brush, "bind a brush to the held item") {
+    struct SphereParams {
+        CommandBlockName block;
+        int              radius{2};
+    };
+    command.overload<SphereParams>()
+        .text("sphere")
+        .required("block")
+        .optional("radius")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, SphereParams const& params) {
+                auto player = checkPlayer(ctx);
+                if (!player) return;
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                auto& item = player->getSelectedItem();
+                if (item.isNull()) {
+                    ctx.error("hold an item to bind the brush to");
+                    return;
+                }
+                getLocalContext(ctx)->brushes[item.getFullNameHash()] =
+                    std::make_shared<SphereBrush>(
+                        std::max(params.radius, 0),
+                        BlockPair{block, BedrockBlocks::mAir}
+                    );
+                ctx.success("sphere brush bound to {0}", item.getTypeName());
+            }
+        );
+    struct CubeParams {
+        CommandBlockName block;
+        int              size{2};
+    };
+    command.overload<CubeParams>()
+        .text("cube")
+        .required("block")
+        .optional("size")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, CubeParams const& params) {
+                auto player = checkPlayer(ctx);
+                if (!player) return;
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                auto& item = player->getSelectedItem();
+                if (item.isNull()) {
+                    ctx.error("hold an item to bind the brush to");
+                    return;
+                }
+                getLocalContext(ctx)->brushes[item.getFullNameHash()] =
+                    std::make_shared<CubeBrush>(
+                        std::max(params.size, 0),
+                        BlockPair{block, BedrockBlocks::mAir}
+                    );
+                ctx.success("cube brush bound to {0}", item.getTypeName());
+            }
+        );
+    struct GravityParams {
+        int radius{2};
+        struct VaArgs {
+            bool height{};
+        } args;
+    };
+    command.overload<GravityParams>()
+        .text("gravity")
+        .optional("radius")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, GravityParams const& params) {
+                auto player = checkPlayer(ctx);
+                if (!player) return;
+                auto& item = player->getSelectedItem();
+                if (item.isNull()) {
+                    ctx.error("hold an item to bind the brush to");
+                    return;
+                }
+                getLocalContext(ctx)->brushes[item.getFullNameHash()] =
+                    std::make_shared<GravityBrush>(
+                        std::max(params.radius, 0),
+                        params.args.height
+                    );
+                ctx.success("gravity brush bound to {0}", item.getTypeName());
+            }
+        );
+    command.overload().text("none").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx) {
+            auto player = checkPlayer(ctx);
+            if (!player) return;
+            auto lctx = getLocalContext(ctx);
+            lctx->finishStroke();
+            if (lctx->brushes.erase(player->getSelectedItem().getFullNameHash())) {
+                ctx.success("brush unbound");
+            } else {
+                ctx.error("held item doesn't have a brush");
+            }
+        }
+    );
+};
+} // namespace we
@@ -0,0 +1,71 @@
+#include "command/CommandMacro.h"
+#include "utils/Spans.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+REG_CMD(generation, cyl, "generate a vertical cylinder at your feet") {
+    struct Params {
+        CommandBlockName block;
+        int              radius{};
+        int              height{1};
+        struct VaArgs {
+            bool hollow{};
+        } args;
+    };
+    command.overload<Params>()
+        .required("block")
+        .required("radius")
+        .optional("height")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto dim = checkDimension(ctx);
+                if (!dim) return;
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                if (params.height == 0) {
+                    ctx.error("height can't be 0");
+                    return;
+                }
+                BlockPos base   = ctx.origin.getBlockPosition();
+                int      height = params.height;
+                if (height < 0) {
+                    base.y += height + 1;
+                    height  = -height;
+                }
+                auto radius = std::max(params.radius, 0);
+                if (!checkUnlocked(
+                        ctx,
+                        dim->getDimensionId(),
+                        {base - BlockPos{radius, 0, radius},
+                         base + BlockPos{radius, height - 1, radius}}
+                    )) {
+                    return;
+                }
+                // spans bypass the buffer, only the history grows
+                auto side = 2 * (size_t)radius + 1;
+                if (!checkMemory(ctx, side * side * height * sizeof(HistoryRecord::Entry))) {
+                    return;
+                }
+                auto lctx = getLocalContext(ctx);
+                lctx->finishStroke();
+                auto record = std::make_shared<HistoryRecord>(dim->getDimensionId());
+                auto count  = fillShape(
+                    dim->getBlockSourceFromMainChunkSource(),
+                    SpanShape::cylinder(base, radius, height, params.args.hollow),
+                    {block, BedrockBlocks::mAir},
+                    record.get()
+                );
+                lctx->pushHistory(std::move(record));
+                ctx.success("{0} block(s) changed", count);
+            }
+        );
+};
+} // namespace we
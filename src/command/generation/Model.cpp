@@ -0,0 +1,267 @@
+#include "command/CommandMacro.h"
+#include "utils/ObjLoader.h"
+#include "utils/Voxelizer.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+#include <mc/world/level/block/Block.h>
+
+namespace we {
+// The concrete colours surfaces are matched to.
+static constexpr std::array<std::pair<std::string_view, std::array<int, 3>>, 16> palette{{
+    {"minecraft:white_concrete",      {207, 213, 214}},
+    {"minecraft:orange_concrete",     {224, 97, 0}   },
+    {"minecraft:magenta_concrete",    {169, 48, 159} },
+    {"minecraft:light_blue_concrete", {35, 137, 198} },
+    {"minecraft:yellow_concrete",     {241, 175, 21} },
+    {"minecraft:lime_concrete",       {94, 168, 24}  },
+    {"minecraft:pink_concrete",       {213, 101, 142}},
+    {"minecraft:gray_concrete",       {54, 57, 61}   },
+    {"minecraft:light_gray_concrete", {125, 125, 115}},
+    {"minecraft:cyan_concrete",       {21, 119, 136} },
+    {"minecraft:purple_concrete",     {100, 31, 156} },
+    {"minecraft:blue_concrete",       {44, 46, 143}  },
+    {"minecraft:brown_concrete",      {96, 59, 31}   },
+    {"minecraft:green_concrete",      {73, 91, 36}   },
+    {"minecraft:red_concrete",        {142, 32, 32}  },
+    {"minecraft:black_concrete",      {8, 10, 15}    },
+}};
+
+// The palette blocks, null where the registry lacks one. Resolved on the server
+// thread for the match on the pool.
+using PaletteBlocks = std::array<Block const*, palette.size()>;
+
+static PaletteBlocks getPaletteBlocks() {
+    PaletteBlocks res{};
+    for (size_t i = 0; i < palette.size(); ++i) {
+        if (auto block = Block::tryGetFromRegistry(palette[i].first)) {
+            res[i] = block.as_ptr();
+        }
+    }
+    return res;
+}
+
+// Closest palette block to an rgb colour in [0, 1].
+static Block const*
+matchColor(Mesh::Color const& color, PaletteBlocks const& blocks, Block const* fallback) {
+    Block const* res  = fallback;
+    float        best = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < palette.size(); ++i) {
+        if (!blocks[i]) {
+            continue;
+        }
+        auto& rgb = palette[i].second;
+        float dist{};
+        for (int k = 0; k < 3; ++k) {
+            float d  = std::clamp(color[k], 0.0f, 1.0f) * 255 - (float)rgb[k];
+            dist    += d * d;
+        }
+        if (dist < best) {
+            best = dist;
+            res  = blocks[i];
+        }
+    }
+    return res;
+}
+
+// Scales the mesh to height blocks, standing centred on the block base.
+// Returns the blocks it spans, or why it can't be placed.
+static std::expected<BoundingBox, std::string>
+placeMesh(Mesh& mesh, BlockPos const& base, int height) {
+    if (mesh.triangles.empty()) {
+        return std::unexpected{"the model has no faces"};
+    }
+    std::array<float, 3> min{}, max{};
+    for (int k = 0; k < 3; ++k) {
+        auto axis     = [&](Vec3 const& v) { return k == 0 ? v.x : k == 1 ? v.y : v.z; };
+        auto [lo, hi] = std::ranges::minmax(mesh.positions, {}, axis);
+        min[k]        = axis(lo);
+        max[k]        = axis(hi);
+    }
+    if (max[1] <= min[1]) {
+        return std::unexpected{"the model is flat"};
+    }
+    // a hair under height, so the top face stays in the last layer
+    double scale = (height - 1e-3) / (max[1] - min[1]);
+    for (auto& v : mesh.positions) {
+        v = Vec3{
+            (float)(base.x + 0.5 + (v.x - (min[0] + max[0]) / 2) * scale),
+            (float)(base.y + (v.y - min[1]) * scale),
+            (float)(base.z + 0.5 + (v.z - (min[2] + max[2]) / 2) * scale)
+        };
+    }
+    auto [x0, x1] = std::ranges::minmax(mesh.positions, {}, &Vec3::x);
+    auto [y0, y1] = std::ranges::minmax(mesh.positions, {}, &Vec3::y);
+    auto [z0, z1] = std::ranges::minmax(mesh.positions, {}, &Vec3::z);
+    return BoundingBox{
+        {(int)std::floor(x0.x), (int)std::floor(y0.y), (int)std::floor(z0.z)},
+        {(int)std::floor(x1.x), (int)std::floor(y1.y), (int)std::floor(z1.z)}
+    };
+}
+
+// What the edit of /model writes, beside the mesh.
+struct ModelFill {
+    Block const*  block;
+    PaletteBlocks blocks; // all null unless colored
+    bool          solid;
+    bool          colored;
+};
+
+// Voxelizes a placed mesh into buffer, on the pool.
+static void voxelizeModel(
+    Mesh const&            mesh,
+    ModelFill const&       fill,
+    EditBuffer&            buffer,
+    std::stop_token const& stop
+) {
+    VoxelizeResult result;
+    {
+        OperationContext::PhaseScope phase{Phase::Evaluate};
+        TriangleBvh                  bvh{mesh};
+        result = voxelize(mesh, bvh, fill.solid, fill.colored, stop);
+    }
+    if (stop.stop_requested()) {
+        return;
+    }
+    OperationContext::PhaseScope phase{Phase::Iterate};
+    result.blocks.forEachBlock([&](BlockPos const& pos) {
+        auto placed = fill.block;
+        if (auto iter = result.surface.find(pos); iter != result.surface.end()) {
+            auto color = mesh.colorAt(iter->second, pos.center());
+            placed     = matchColor(color, fill.blocks, fill.block);
+        }
+        buffer.set(pos, {placed, BedrockBlocks::mAir});
+    });
+}
+
+// Loads and places the model on the pool, then back on the server thread
+// submits job over the area it turned out to span. Shutdown waits for the load,
+// which can't stop midway.
+static void loadModel(
+    std::filesystem::path          path,
+    BlockPos                       base,
+    int                            height,
+    ModelFill                      fill,
+    EditScheduler::Job             job,
+    std::shared_ptr<MemoryAccount> memory
+) {
+    auto& we = WorldEdit::getInstance();
+    we.getScheduler().prepare(
+        [=, scheduler = we.getScheduler().weak_from_this()](std::stop_token const& stop) {
+            auto mesh = loadObj(path).and_then([&](Mesh&& loaded) {
+                return placeMesh(loaded, base, height).transform([&](BoundingBox area) {
+                    auto placed = std::make_shared<Mesh const>(std::move(loaded));
+                    return std::pair{std::move(placed), area};
+                });
+            });
+            if (stop.stop_requested()) {
+                return;
+            }
+            ll::thread::ServerThreadExecutor::getDefault().execute([=]() mutable {
+                if (!mesh) {
+                    notifyPlayer(job.owner, "can't load the model: {0}", mesh.error());
+                    return;
+                }
+                auto self = scheduler.lock();
+                if (!self) {
+                    return;
+                }
+                // the footprint is only known once the model is scaled
+                MemoryAccount::Scope account{memory};
+                auto                 side = mesh->second.getSideLength();
+                if (!checkMemory(
+                        job.owner,
+                        EditBuffer::estimateMemory((uint64)side.x * side.z * side.y)
+                    )) {
+                    return;
+                }
+                job.area    = mesh->second;
+                job.compute = [fill, mesh = mesh->first](
+                                  EditBuffer&            buffer,
+                                  std::stop_token const& stop
+                              ) { voxelizeModel(*mesh, fill, buffer, stop); };
+                self->submit(std::move(job));
+            });
+        }
+    );
+}
+
+REG_CMD(generation, model, "import an obj model from the models folder at your feet") {
+    struct Params {
+        CommandBlockName block;
+        std::string      file;
+        int              height{};
+        struct VaArgs {
+            bool hollow{};
+            bool colored{};
+        } args;
+    };
+    command.overload<Params>()
+        .required("block")
+        .required("file")
+        .required("height")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto dim = checkDimension(ctx);
+                if (!dim) return;
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                if (params.height <= 0) {
+                    ctx.error("height must be positive");
+                    return;
+                }
+                auto& range = dim->mHeightRange.get();
+                if (params.height > range.mMax - range.mMin) {
+                    ctx.error("height can be at most {0}", range.mMax - range.mMin);
+                    return;
+                }
+                auto path = WorldEdit::getInstance().getSelf().getDataDir() / u8"models"
+                          / std::filesystem::path{params.file}.filename();
+                auto lctx = getLocalContext(ctx);
+                lctx->finishStroke();
+
+                // loaded, voxelized and written off the command; where the model
+                // stands, and so what it locks, is known once it is loaded
+                auto&              scheduler = WorldEdit::getInstance().getScheduler();
+                EditScheduler::Job job;
+                job.owner    = lctx->getUuid();
+                job.name     = ctx.cmd.getCommandName();
+                job.dim      = dim->getDimensionId();
+                job.priority = scheduler.getGovernor().getPriority(
+                    ctx.origin.getPermissionsLevel()
+                );
+                job.finish = [owner = job.owner](EditScheduler::Result result) {
+                    auto& we = WorldEdit::getInstance();
+                    if (auto lctx = we.getLocalContextManager().get(owner); lctx) {
+                        lctx->pushHistory(std::move(result.record));
+                        lctx->recordOperation(std::move(result.stats));
+                    } else {
+                        we.recordOperation(result.stats);
+                    }
+                    notifyPlayer(owner, "{0} block(s) changed", result.changed);
+                };
+                ModelFill fill{
+                    block,
+                    params.args.colored ? getPaletteBlocks() : PaletteBlocks{},
+                    !params.args.hollow,
+                    params.args.colored,
+                };
+                loadModel(
+                    std::move(path),
+                    ctx.origin.getBlockPosition(),
+                    params.height,
+                    fill,
+                    std::move(job),
+                    lctx->memory
+                );
+                ctx.success("loading the model in the background");
+            }
+        );
+};
+} // namespace we
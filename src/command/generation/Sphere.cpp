@@ -0,0 +1,59 @@
+#include "command/CommandMacro.h"
+#include "utils/Spans.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+REG_CMD(generation, sphere, "generate a sphere around you") {
+    struct Params {
+        CommandBlockName block;
+        int              radius{};
+        struct VaArgs {
+            bool hollow{};
+        } args;
+    };
+    command.overload<Params>()
+        .required("block")
+        .required("radius")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto dim = checkDimension(ctx);
+                if (!dim) return;
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                auto center = ctx.origin.getBlockPosition();
+                auto radius = std::max(params.radius, 0);
+                if (!checkUnlocked(
+                        ctx,
+                        dim->getDimensionId(),
+                        {center - radius, center + radius}
+                    )) {
+                    return;
+                }
+                // spans bypass the buffer, only the history grows
+                auto side = 2 * (size_t)radius + 1;
+                if (!checkMemory(ctx, side * side * side * sizeof(HistoryRecord::Entry))) {
+                    return;
+                }
+                auto lctx = getLocalContext(ctx);
+                lctx->finishStroke();
+                auto record = std::make_shared<HistoryRecord>(dim->getDimensionId());
+                auto count  = fillShape(
+                    dim->getBlockSourceFromMainChunkSource(),
+                    SpanShape::sphere(center, radius, params.args.hollow),
+                    {block, BedrockBlocks::mAir},
+                    record.get()
+                );
+                lctx->pushHistory(std::move(record));
+                ctx.success("{0} block(s) changed", count);
+            }
+        );
+};
+} // namespace we
@@ -0,0 +1,32 @@
+#include "command/CommandMacro.h"
+
+namespace we {
+REG_CMD(history, redo, "redo the last undone edit") {
+    command.overload().execute(CmdCtxBuilder{} | [](CommandContextRef const& ctx) {
+        auto lctx = checkLocalContext(ctx);
+        if (!lctx) return;
+        // its record isn't in the history yet
+        if (WorldEdit::getInstance().getScheduler().hasJobs(lctx->getUuid())) {
+            ctx.error("wait until your running edit finishes");
+            return;
+        }
+        lctx->finishStroke();
+        auto record = lctx->history.redo();
+        if (!record) {
+            ctx.error("nothing to redo");
+            return;
+        }
+        if (!checkUnlocked(ctx, record->getDim(), record->getBoundingBox())) {
+            lctx->history.undo();
+            return;
+        }
+        auto blockSource = getBlockSource(record->getDim());
+        if (!blockSource) {
+            lctx->history.undo();
+            ctx.error("dimension of the edit isn't loaded");
+            return;
+        }
+        ctx.success("redid {0} block(s)", record->redo(*blockSource));
+    });
+};
+} // namespace we
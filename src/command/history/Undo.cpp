@@ -0,0 +1,32 @@
+#include "command/CommandMacro.h"
+
+namespace we {
+REG_CMD(history, undo, "undo the last edit") {
+    command.overload().execute(CmdCtxBuilder{} | [](CommandContextRef const& ctx) {
+        auto lctx = checkLocalContext(ctx);
+        if (!lctx) return;
+        // its record isn't in the history yet
+        if (WorldEdit::getInstance().getScheduler().hasJobs(lctx->getUuid())) {
+            ctx.error("wait until your running edit finishes");
+            return;
+        }
+        lctx->finishStroke();
+        auto record = lctx->history.undo();
+        if (!record) {
+            ctx.error("nothing to undo");
+            return;
+        }
+        if (!checkUnlocked(ctx, record->getDim(), record->getBoundingBox())) {
+            lctx->history.redo();
+            return;
+        }
+        auto blockSource = getBlockSource(record->getDim());
+        if (!blockSource) {
+            lctx->history.redo();
+            ctx.error("dimension of the edit isn't loaded");
+            return;
+        }
+        ctx.success("undid {0} block(s)", record->undo(*blockSource));
+    });
+};
+} // namespace we
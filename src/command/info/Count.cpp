@@ -0,0 +1,42 @@
+#include "command/CommandMacro.h"
+#include "world/BlockHistogram.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/block/Block.h>
+
+namespace we {
+REG_CMD(info, count, "count a block in the region") {
+    struct Params {
+        CommandBlockName block;
+        struct VaArgs {
+            bool data{};
+        } args;
+    };
+    command.overload<Params>().required("block").optional("args").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, Params const& params) {
+            auto region = checkRegion(ctx);
+            if (!region) return;
+            auto blockSource = getBlockSource(region->getDim());
+            if (!blockSource) {
+                ctx.error("dimension of the region isn't loaded");
+                return;
+            }
+            auto block = params.block.resolveBlock(0).getBlock();
+            if (!block) {
+                ctx.error("unknown block");
+                return;
+            }
+            uint64 count{};
+            for (auto& [b, n] : BlockHistogram::count(*blockSource, *region).sorted()) {
+                if (params.args.data ? b == block
+                                     : b->getTypeName() == block->getTypeName()) {
+                    count += n;
+                }
+            }
+            ctx.success("{0} block(s) found", count);
+        }
+    );
+};
+} // namespace we
@@ -0,0 +1,55 @@
+#include "command/CommandMacro.h"
+#include "world/BlockHistogram.h"
+
+#include <mc/world/level/block/Block.h>
+
+namespace we {
+REG_CMD(info, distr, "list the block distribution of the region") {
+    struct Params {
+        struct VaArgs {
+            bool data{};
+        } args;
+    };
+    command.overload<Params>().optional("args").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, Params const& params) {
+            auto region = checkRegion(ctx);
+            if (!region) return;
+            auto blockSource = getBlockSource(region->getDim());
+            if (!blockSource) {
+                ctx.error("dimension of the region isn't loaded");
+                return;
+            }
+            auto histogram = BlockHistogram::count(*blockSource, *region);
+            auto total     = histogram.total();
+
+            // names are only built here, once per distinct block
+            std::vector<std::pair<std::string, uint64>> entries;
+            phmap::flat_hash_map<std::string, size_t>   indices;
+            for (auto& [block, n] : histogram.sorted()) {
+                std::string name{block->getTypeName()};
+                if (params.args.data) {
+                    name += ' ';
+                    name += block->getSerializationId().at("states").toSnbt(
+                        SnbtFormat::Minimize,
+                        0
+                    );
+                }
+                auto [iter, inserted] = indices.try_emplace(name, entries.size());
+                if (inserted) {
+                    entries.emplace_back(std::move(name), n);
+                } else {
+                    entries[iter->second].second += n;
+                }
+            }
+            std::ranges::stable_sort(entries, std::greater{}, [](auto& e) {
+                return e.second;
+            });
+            ctx.success("{0} block(s) in total", total);
+            for (auto& [name, n] : entries) {
+                ctx.success("{0}: {1} ({2:.2f}%)", name, n, 100.0 * n / total);
+            }
+        }
+    );
+};
+} // namespace we
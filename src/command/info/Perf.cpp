@@ -0,0 +1,117 @@
+#include "command/CommandMacro.h"
+
+#include <numeric>
+
+namespace we {
+static double toMilliseconds(OperationStats::Duration d) {
+    return std::chrono::duration<double, std::milli>(d).count();
+}
+
+// The share of each phase in the total time, longest first.
+static std::string formatPhases(
+    std::array<OperationStats::Duration, phaseCount> const& phases,
+    OperationStats::Duration                                total
+) {
+    std::array<size_t, phaseCount> order;
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, std::greater{}, [&](size_t i) { return phases[i]; });
+    std::string res;
+    for (auto i : order) {
+        if (phases[i] == OperationStats::Duration{}) {
+            break;
+        }
+        res += fmt::format(
+            "{0}{1} {2:.0f}%",
+            res.empty() ? "" : ", ",
+            getPhaseName((Phase)i),
+            100 * toMilliseconds(phases[i]) / std::max(toMilliseconds(total), 1e-9)
+        );
+    }
+    return res;
+}
+
+static void showMemory(CommandContextRef const& ctx, MemoryAccount const& account) {
+    std::string categories;
+    for (size_t i = 0; i < memoryCategoryCount; ++i) {
+        categories += fmt::format(
+            "{0}{1} {2} KiB",
+            i ? ", " : "",
+            getMemoryCategoryName((MemoryCategory)i),
+            account.get((MemoryCategory)i) / 1024
+        );
+    }
+    ctx.success("{0} KiB held; {1}", account.total() / 1024, categories);
+}
+
+static void showServer(CommandContextRef const& ctx) {
+    auto& scheduler = WorldEdit::getInstance().getScheduler();
+    ctx.success(
+        "{0} scheduled edit(s), writing {1} block(s) per tick",
+        scheduler.size(),
+        scheduler.getGovernor().getBudget()
+    );
+    auto summary = WorldEdit::getInstance().getTelemetry().summarize();
+    if (summary.samples == 0) {
+        ctx.error("no operation recorded yet");
+        return;
+    }
+    ctx.success(
+        "{0} operation(s) since start, of the last {1}: p50 {2:.4g} blocks/s, p99 {3:.4g} "
+        "blocks/s, {4} block(s) written in {5:.1f}ms; {6}",
+        summary.count,
+        summary.samples,
+        summary.p50,
+        summary.p99,
+        summary.blocksWritten,
+        toMilliseconds(summary.total),
+        formatPhases(summary.phases, summary.total)
+    );
+}
+
+REG_CMD(info, perf, "show where the time of recent operations went") {
+    struct Params {
+        struct VaArgs {
+            bool server{};
+            bool memory{};
+        } args;
+    };
+    command.overload<Params>().optional("args").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, Params const& params) {
+            auto lctx = WorldEdit::getInstance().getLocalContextManager().get(ctx.origin);
+            if (params.args.memory) {
+                showMemory(
+                    ctx,
+                    params.args.server || !lctx ? MemoryAccount::server() : *lctx->memory
+                );
+                return;
+            }
+            if (params.args.server || !lctx) {
+                showServer(ctx);
+                return;
+            }
+            if (lctx->operations.empty()) {
+                ctx.error("no operation recorded yet");
+                return;
+            }
+            for (auto& op : lctx->operations) {
+                ctx.success(
+                    "{0}: {1} of {2} block(s) written in {3:.1f}ms, {4:.4g} blocks/s, {5} "
+                    "chunk lookup(s), {6} KiB peak, {7} KiB of temporaries in {8} new "
+                    "block(s); {9}",
+                    op.name,
+                    op.blocksWritten,
+                    op.blocksTouched,
+                    toMilliseconds(op.total),
+                    op.blocksPerSecond(),
+                    op.chunkLookups,
+                    op.peakMemory / 1024,
+                    op.arenaBytes / 1024,
+                    op.allocations,
+                    formatPhases(op.phases, op.total)
+                );
+            }
+        }
+    );
+};
+} // namespace we
@@ -0,0 +1,38 @@
+#include "command/CommandMacro.h"
+#include "utils/Trace.h"
+
+namespace we {
+REG_CMD(info, trace, "record a chrome trace of the edit pipeline") {
+    command.overload().text("start").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx) {
+            if (trace::enabled) {
+                ctx.error("tracing is already running");
+                return;
+            }
+            trace::start();
+            ctx.success("tracing started");
+        }
+    );
+    command.overload().text("stop").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx) {
+            if (!trace::enabled) {
+                ctx.error("tracing isn't running");
+                return;
+            }
+            using namespace std::chrono;
+            trace::stop();
+            auto time  = duration_cast<seconds>(system_clock::now().time_since_epoch());
+            auto path  = WorldEdit::getInstance().getSelf().getDataDir() / u8"traces"
+                      / fmt::format("trace-{0}.json", time.count());
+            auto count = trace::dump(path);
+            if (!count) {
+                ctx.error("can't write the trace");
+                return;
+            }
+            ctx.success("{0} span(s) written to {1}", *count, path.filename().string());
+        }
+    );
+};
+} // namespace we
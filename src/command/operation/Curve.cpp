@@ -0,0 +1,99 @@
+#include "command/CommandMacro.h"
+#include "utils/Bresenham.h"
+#include "utils/Capsule.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+REG_CMD(operation, curve, "draw a smooth curve through the vertices of the region") {
+    struct Params {
+        CommandBlockName block;
+        int              radius{};
+        struct VaArgs {
+            bool hollow{};
+        } args;
+    };
+    command.overload<Params>()
+        .required("block")
+        .optional("radius")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto region = checkRegion(ctx);
+                if (!region) return;
+                auto blockSource = getBlockSource(region->getDim());
+                if (!blockSource) {
+                    ctx.error("dimension of the region isn't loaded");
+                    return;
+                }
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                std::vector<Node> nodes;
+                region->forEachLine([&](BlockPos const& from, BlockPos const& to) {
+                    if (nodes.empty()) {
+                        nodes.emplace_back(from);
+                    }
+                    nodes.emplace_back(to);
+                });
+                if (nodes.size() < 2) {
+                    ctx.error("region has no lines");
+                    return;
+                }
+                int            radius = std::max(params.radius, 0);
+                SparseBlockSet set;
+                {
+                    OperationContext::PhaseScope phase{Phase::Evaluate};
+                    KochanekBartelsInterpolation curve{std::move(nodes)};
+
+                    std::vector<double> arcs;
+                    double              length{};
+                    for (int i = 0; i < curve.segCount; i++) {
+                        length += arcs.emplace_back(curve.arcLength(i));
+                    }
+                    auto blocks = estimatePolylineBlocks(length, radius);
+                    if (!checkMemory(ctx, estimateFillSetMemory(blocks))) {
+                        return;
+                    }
+                    auto box = region->getBoundingBox();
+                    box.min  = box.min - radius;
+                    box.max  = box.max + radius;
+                    if (!checkUnlocked(ctx, region->getDim(), box)) {
+                        return;
+                    }
+
+                    // two samples per block of arc keep the chords within the blocks
+                    std::vector<Vec3> points;
+                    for (int i = 0; i < curve.segCount; i++) {
+                        int count = std::max((int)std::ceil(arcs[i] * 2), 1);
+                        for (int j = 0; j < count; j++) {
+                            points.emplace_back(curve.getPosition(i, j / (double)count));
+                        }
+                    }
+                    points.emplace_back(curve.getPosition(1.0));
+
+                    rasterizePolyline(set, points, radius);
+                    if (params.args.hollow) {
+                        set = set.shell();
+                    }
+                }
+                // the spline may swing out of the box of its vertices
+                if (!checkUnlocked(ctx, region->getDim(), set.getTileBox())) {
+                    return;
+                }
+                auto lctx = getLocalContext(ctx);
+                lctx->finishStroke();
+                auto record = std::make_shared<HistoryRecord>(region->getDim());
+                auto count =
+                    fillSet(*blockSource, set, {block, BedrockBlocks::mAir}, record.get());
+                lctx->pushHistory(std::move(record));
+                ctx.success("{0} block(s) changed", count);
+            }
+        );
+};
+} // namespace we
@@ -0,0 +1,133 @@
+#include "command/CommandMacro.h"
+#include "utils/Expression.h"
+#include "utils/ImplicitOctree.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+REG_CMD(operation, gen, "generate the shape where a function of x y z is true") {
+    struct Params {
+        CommandBlockName block;
+        std::string      function;
+        struct VaArgs {
+            bool hollow{};
+            bool raw{};
+        } args;
+    };
+    command.overload<Params>()
+        .required("block")
+        .required("function")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto region = checkRegion(ctx);
+                if (!region) return;
+                auto blockSource = getBlockSource(region->getDim());
+                if (!blockSource) {
+                    ctx.error("dimension of the region isn't loaded");
+                    return;
+                }
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                static constexpr std::array<std::string_view, 3> vars{"x", "y", "z"};
+                auto expression = Expression::compile(params.function, vars);
+                if (!expression) {
+                    ctx.error("invalid function: {0}", expression.error());
+                    return;
+                }
+                if (!checkMemory(ctx, EditBuffer::estimateMemory(region->size()))) {
+                    return;
+                }
+                auto box = region->getBoundingBox();
+
+                // x y z span [-1, 1] over the block centres of the bounding box,
+                // or are the block coordinates with -r
+                struct Axis {
+                    double origin;
+                    double scale;
+
+                    double operator()(double v) const { return (v - origin) * scale; }
+                };
+                auto axis = [&](int min, int max) {
+                    if (params.args.raw) {
+                        return Axis{0, 1};
+                    }
+                    return Axis{(min + max) / 2.0, 2.0 / std::max(max - min, 1)};
+                };
+                std::array<Axis, 3> axes{
+                    axis(box.min.x, box.max.x),
+                    axis(box.min.y, box.max.y),
+                    axis(box.min.z, box.max.z),
+                };
+                auto lctx = getLocalContext(ctx);
+                lctx->finishStroke();
+
+                // evaluated on the thread pool, the region is kept from changing
+                // until the edit is done
+                auto&              scheduler = WorldEdit::getInstance().getScheduler();
+                EditScheduler::Job job;
+                job.owner    = lctx->getUuid();
+                job.name     = ctx.cmd.getCommandName();
+                job.dim      = region->getDim();
+                job.area     = box;
+                job.priority = scheduler.getGovernor().getPriority(
+                    ctx.origin.getPermissionsLevel()
+                );
+                job.compute = [region,
+                               box,
+                               axes,
+                               block,
+                               hollow     = params.args.hollow,
+                               expression = std::move(*expression)](
+                                  EditBuffer&            buffer,
+                                  std::stop_token const& stop
+                              ) {
+                    auto bound = [&](BoundingBox const& cell) {
+                        if (stop.stop_requested()) {
+                            // decides every cell left as empty
+                            return Interval{0, 0};
+                        }
+                        std::array<Interval, 3> v{
+                            Interval{axes[0](cell.min.x), axes[0](cell.max.x)},
+                            Interval{axes[1](cell.min.y), axes[1](cell.max.y)},
+                            Interval{axes[2](cell.min.z), axes[2](cell.max.z)},
+                        };
+                        return expression.eval(v);
+                    };
+                    auto test = [&](BlockPos const& pos) {
+                        std::array<double, 3> v{
+                            axes[0](pos.x),
+                            axes[1](pos.y),
+                            axes[2](pos.z),
+                        };
+                        return expression.eval(v) > 0.5;
+                    };
+                    OperationContext::PhaseScope phase{Phase::Evaluate};
+                    forEachImplicitBlock(box, hollow, bound, test, [&](BlockPos const& pos) {
+                        if (region->contains(pos)) {
+                            buffer.set(pos, {block, BedrockBlocks::mAir});
+                        }
+                    });
+                };
+                job.finish = [owner = job.owner](EditScheduler::Result result) {
+                    auto& we = WorldEdit::getInstance();
+                    if (auto lctx = we.getLocalContextManager().get(owner); lctx) {
+                        lctx->pushHistory(std::move(result.record));
+                        lctx->recordOperation(std::move(result.stats));
+                    } else {
+                        we.recordOperation(result.stats);
+                    }
+                    notifyPlayer(owner, "{0} block(s) changed", result.changed);
+                };
+                scheduler.submit(std::move(job));
+                ctx.success("generating in the background");
+            }
+        );
+};
+} // namespace we
@@ -0,0 +1,128 @@
+#include "command/CommandMacro.h"
+#include "utils/DistanceTransform.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+#include <mc/world/level/block/Block.h>
+
+namespace we {
+// Keeps a shell of thickness + 1 blocks, so 0 keeps the blocks touching air.
+// Blocks outside the region count as air, unless realAir leaves only real air.
+static void hollow(
+    CommandContextRef const& ctx,
+    int                      thickness,
+    DistanceMetric           metric,
+    Block const&             fill,
+    bool                     realAir
+) {
+    auto region = checkRegion(ctx);
+    if (!region) return;
+    auto blockSource = getBlockSource(region->getDim());
+    if (!blockSource) {
+        ctx.error("dimension of the region isn't loaded");
+        return;
+    }
+    int shell = std::max(thickness, 0) + 1;
+
+    // padded by a block when all outside is air, by the shell when only real
+    // air beyond the region makes one
+    auto box  = region->getBoundingBox();
+    auto pad  = realAir ? shell : 1;
+    box.min  -= pad;
+    box.max  += pad;
+    if (!checkUnlocked(ctx, region->getDim(), box)) {
+        return;
+    }
+    int sizex = box.max.x - box.min.x + 1;
+    int sizey = box.max.y - box.min.y + 1;
+    int sizez = box.max.z - box.min.z + 1;
+
+    // the air bitmap and its distances on top of the edit
+    auto volume = (size_t)sizex * sizey * sizez;
+    if (!checkMemory(
+            ctx,
+            EditBuffer::estimateMemory(region->size()) + volume * (1 + sizeof(int))
+        )) {
+        return;
+    }
+
+    std::optional<OperationContext::PhaseScope> phase{std::in_place, Phase::Iterate};
+    OperationContext::addTouched(volume);
+
+    std::pmr::vector<uint8_t> air(volume, OperationContext::arena());
+    size_t                    i{};
+    for (int y = box.min.y; y <= box.max.y; ++y) {
+        for (int z = box.min.z; z <= box.max.z; ++z) {
+            for (int x = box.min.x; x <= box.max.x; ++x) {
+                BlockPos pos{x, y, z};
+                air[i++] = (!realAir && !region->contains(pos))
+                        || blockSource->getBlock(pos).isAir();
+            }
+        }
+    }
+    phase.emplace(Phase::Evaluate);
+    auto dist  = distanceTransform(air, sizex, sizey, sizez, metric);
+    auto limit = distanceLimit(metric, shell);
+    OperationContext::noteMemory(air.size() * sizeof(air[0]) + dist.size() * sizeof(dist[0]));
+
+    phase.emplace(Phase::Iterate);
+    EditBuffer buffer;
+    region->forEachBlockInRegion([&](BlockPos const& pos) {
+        auto local = pos - box.min;
+        if (dist[((size_t)local.y * sizez + local.z) * sizex + local.x] > limit) {
+            buffer.set(pos, {&fill, BedrockBlocks::mAir});
+        }
+    });
+    phase.reset();
+    auto lctx = getLocalContext(ctx);
+    lctx->finishStroke();
+    auto record = std::make_shared<HistoryRecord>(region->getDim());
+    auto count  = buffer.flush(*blockSource, record.get());
+    lctx->pushHistory(std::move(record));
+    ctx.success("{0} block(s) changed", count);
+}
+
+REG_CMD(operation, hollow, "hollow out the solid blocks of the region") {
+    struct Params {
+        int              thickness{};
+        CommandBlockName block;
+        DistanceMetric   metric{DistanceMetric::Manhattan};
+        struct VaArgs {
+            bool realair{};
+        } args;
+    };
+    command.overload<Params>()
+        .optional("thickness")
+        .optional("metric")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                hollow(
+                    ctx,
+                    params.thickness,
+                    params.metric,
+                    *BedrockBlocks::mAir,
+                    params.args.realair
+                );
+            }
+        );
+    command.overload<Params>()
+        .required("thickness")
+        .required("block")
+        .optional("metric")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                hollow(ctx, params.thickness, params.metric, *block, params.args.realair);
+            }
+        );
+};
+} // namespace we
@@ -0,0 +1,76 @@
+#include "command/CommandMacro.h"
+#include "utils/Capsule.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+REG_CMD(operation, line, "draw the lines of the region") {
+    struct Params {
+        CommandBlockName block;
+        int              radius{};
+        struct VaArgs {
+            bool hollow{};
+        } args;
+    };
+    command.overload<Params>()
+        .required("block")
+        .optional("radius")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto region = checkRegion(ctx);
+                if (!region) return;
+                auto blockSource = getBlockSource(region->getDim());
+                if (!blockSource) {
+                    ctx.error("dimension of the region isn't loaded");
+                    return;
+                }
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                int    radius = std::max(params.radius, 0);
+                uint64 blocks{};
+                region->forEachLine([&](BlockPos const& from, BlockPos const& to) {
+                    auto length  = from.center().distanceTo(to.center());
+                    blocks      += estimatePolylineBlocks(length, radius);
+                });
+                if (!checkMemory(ctx, estimateFillSetMemory(blocks))) {
+                    return;
+                }
+                auto box = region->getBoundingBox();
+                box.min  = box.min - radius;
+                box.max  = box.max + radius;
+                if (!checkUnlocked(ctx, region->getDim(), box)) {
+                    return;
+                }
+                SparseBlockSet set;
+                {
+                    OperationContext::PhaseScope phase{Phase::Evaluate};
+                    region->forEachLine([&](BlockPos const& from, BlockPos const& to) {
+                        std::array<Vec3, 2> points{from.center(), to.center()};
+                        rasterizePolyline(set, points, radius);
+                    });
+                }
+                if (set.empty()) {
+                    ctx.error("region has no lines");
+                    return;
+                }
+                if (params.args.hollow) {
+                    set = set.shell();
+                }
+                auto lctx = getLocalContext(ctx);
+                lctx->finishStroke();
+                auto record = std::make_shared<HistoryRecord>(region->getDim());
+                auto count =
+                    fillSet(*blockSource, set, {block, BedrockBlocks::mAir}, record.get());
+                lctx->pushHistory(std::move(record));
+                ctx.success("{0} block(s) changed", count);
+            }
+        );
+};
+} // namespace we
@@ -0,0 +1,70 @@
+#include "command/CommandMacro.h"
+#include "utils/FacingUtils.h"
+#include "world/BlockMove.h"
+
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+REG_CMD(operation, move, "move the blocks of the region") {
+    struct Params {
+        int           dis{};
+        CommandFacing facing{CommandFacing::Me};
+        struct VaArgs {
+            bool shift{};
+        } args;
+    };
+    command.overload<Params>()
+        .required("dis")
+        .optional("facing")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto region = checkRegion(ctx);
+                if (!region) return;
+                auto blockSource = getBlockSource(region->getDim());
+                if (!blockSource) {
+                    ctx.error("dimension of the region isn't loaded");
+                    return;
+                }
+                auto facing = checkFacing(params.facing, ctx);
+                if (!facing) return;
+                auto offset = facingToDir(*facing, params.dis);
+                auto box    = region->getBoundingBox();
+                if (!checkUnlocked(
+                        ctx,
+                        region->getDim(),
+                        box.merge({box.min + offset, box.max + offset})
+                    )) {
+                    return;
+                }
+                // one sub chunk layer of writes at a time, and a record of up to
+                // every block moved and vacated
+                auto layer = (uint64)(box.max.x - box.min.x + 1) * (box.max.z - box.min.z + 1)
+                           * 16;
+                if (!checkMemory(
+                        ctx,
+                        EditBuffer::estimateMemory(std::min(layer, region->size()))
+                            + 2 * region->size() * sizeof(HistoryRecord::Entry)
+                    )) {
+                    return;
+                }
+                auto lctx = getLocalContext(ctx);
+                lctx->finishStroke();
+                auto record = std::make_shared<HistoryRecord>(region->getDim());
+                auto count  = moveBlocks(
+                    *blockSource,
+                    *region,
+                    offset,
+                    {BedrockBlocks::mAir, BedrockBlocks::mAir},
+                    *record
+                );
+                lctx->pushHistory(std::move(record));
+                if (params.args.shift) {
+                    region->shift(offset);
+                }
+                ctx.success("{0} block(s) changed", count);
+            }
+        );
+};
+} // namespace we
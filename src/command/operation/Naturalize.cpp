@@ -0,0 +1,117 @@
+#include "command/CommandMacro.h"
+#include "world/ColumnSnapshot.h"
+
+#include <mc/world/level/block/Block.h>
+
+namespace we {
+// Blocks naturalize may turn into one another.
+static constexpr std::array<std::string_view, 9> naturalBlocks{
+    "minecraft:grass_block",
+    "minecraft:dirt",
+    "minecraft:coarse_dirt",
+    "minecraft:podzol",
+    "minecraft:mycelium",
+    "minecraft:stone",
+    "minecraft:granite",
+    "minecraft:diorite",
+    "minecraft:andesite",
+};
+
+static bool isNatural(Block const& block) {
+    return std::ranges::find(naturalBlocks, std::string_view{block.getTypeName()})
+        != naturalBlocks.end();
+}
+
+// Each stretch of natural blocks from the top down becomes a top layer, depth
+// layers under it and stone below, every other block starting a new stretch.
+static ColumnRuns<BlockPair> naturalize(
+    ColumnSnapshot::Column const& column,
+    int                           depth,
+    std::array<Block const*, 3>   layers
+) {
+    ColumnRuns<BlockPair> res;
+    res.reserve(column.size() + 2);
+    int above = 0; // natural blocks above in the stretch
+    for (auto run = column.rbegin(); run != column.rend(); ++run) {
+        if (!isNatural(*run->value.block)) {
+            above = 0;
+            res.push_back(*run);
+            continue;
+        }
+        for (int y = run->end(); y > run->y;) {
+            int layer  = above == 0 ? 0 : above <= depth ? 1 : 2;
+            int length = layer == 0 ? 1 : layer == 1 ? depth + 1 - above : y - run->y;
+            length     = std::min(length, y - run->y);
+            y         -= length;
+            above     += length;
+            res.push_back({y, length, {layers[layer], run->value.extra}});
+        }
+    }
+    // built top down, merge the runs bottom up
+    ColumnRuns<BlockPair> merged;
+    merged.reserve(res.size());
+    for (auto run = res.rbegin(); run != res.rend(); ++run) {
+        appendRun(merged, run->y, run->length, run->value);
+    }
+    return merged;
+}
+
+REG_CMD(operation, naturalize, "turn the terrain of the region into grass, dirt and stone") {
+    struct Params {
+        int depth{3};
+    };
+    command.overload<Params>().optional("depth").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, Params const& params) {
+            auto region = checkRegion(ctx);
+            if (!region) return;
+            auto blockSource = getBlockSource(region->getDim());
+            if (!blockSource) {
+                ctx.error("dimension of the region isn't loaded");
+                return;
+            }
+            auto grass = Block::tryGetFromRegistry("minecraft:grass_block");
+            auto dirt  = Block::tryGetFromRegistry("minecraft:dirt");
+            auto stone = Block::tryGetFromRegistry("minecraft:stone");
+            if (!grass || !dirt || !stone) {
+                ctx.error("unknown block");
+                return;
+            }
+            int  depth = std::max(params.depth, 0);
+            auto box   = region->getBoundingBox();
+            if (!checkUnlocked(ctx, region->getDim(), box)) {
+                return;
+            }
+            if (!checkMemory(
+                    ctx,
+                    ColumnSnapshot::estimateMemory(box)
+                        + EditBuffer::estimateMemory(region->size())
+                )) {
+                return;
+            }
+            EditBuffer buffer;
+            {
+                OperationContext::PhaseScope phase{Phase::Iterate};
+                ColumnSnapshot               snapshot{*blockSource, box};
+                snapshot.transform(
+                    [&](Pos2d, ColumnSnapshot::Column const& column) {
+                        return naturalize(
+                            column,
+                            depth,
+                            {grass.as_ptr(), dirt.as_ptr(), stone.as_ptr()}
+                        );
+                    },
+                    buffer,
+                    [&](BlockPos const& pos) { return region->contains(pos); }
+                );
+            }
+            auto lctx = getLocalContext(ctx);
+            lctx->finishStroke();
+            auto record = std::make_shared<HistoryRecord>(region->getDim());
+            auto count  = buffer.flush(*blockSource, record.get());
+            lctx->pushHistory(std::move(record));
+            ctx.success("{0} block(s) changed", count);
+        }
+    );
+};
+} // namespace we
@@ -0,0 +1,83 @@
+#include "command/CommandMacro.h"
+#include "world/ColumnSnapshot.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+#include <mc/world/level/block/Block.h>
+
+namespace we {
+REG_CMD(operation, overlay, "cover the top of every column of the region") {
+    struct Params {
+        CommandBlockName block;
+    };
+    command.overload<Params>().required("block").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, Params const& params) {
+            auto region = checkRegion(ctx);
+            if (!region) return;
+            auto blockSource = getBlockSource(region->getDim());
+            if (!blockSource) {
+                ctx.error("dimension of the region isn't loaded");
+                return;
+            }
+            auto block = params.block.resolveBlock(0).getBlock();
+            if (!block) {
+                ctx.error("unknown block");
+                return;
+            }
+            auto box = region->getBoundingBox();
+            if (!checkUnlocked(ctx, region->getDim(), box)) {
+                return;
+            }
+            auto side    = box.getSideLength();
+            auto columns = (uint64)side.x * side.z;
+            if (!checkMemory(
+                    ctx,
+                    ColumnSnapshot::estimateMemory(box) + EditBuffer::estimateMemory(columns)
+                )) {
+                return;
+            }
+            EditBuffer buffer;
+            {
+                OperationContext::PhaseScope phase{Phase::Iterate};
+                ColumnSnapshot               snapshot{*blockSource, box};
+                auto&                        top = snapshot.getBoundingBox().max.y;
+                // Columns are walked on this thread: containment is tested only from
+                // the top down to the first solid block inside, a few calls a column.
+                for (size_t i = 0; i < snapshot.size(); ++i) {
+                    auto               xz     = snapshot.getColumnPos(i);
+                    auto&              column = snapshot.at(i);
+                    std::optional<int> found;
+                    for (auto run = column.rbegin(); run != column.rend() && !found; ++run) {
+                        if (run->value.block->isAir()) {
+                            continue;
+                        }
+                        for (int y = run->end() - 1; y >= run->y; --y) {
+                            if (region->contains({xz.x, y, xz.z})) {
+                                found = y;
+                                break;
+                            }
+                        }
+                    }
+                    // above the highest block of the column in the region, air as
+                    // anything solid in the region would have been found first
+                    if (!found || *found == top) {
+                        continue;
+                    }
+                    BlockPos pos{xz.x, *found + 1, xz.z};
+                    if (region->contains(pos)) {
+                        buffer.set(pos, {block, BedrockBlocks::mAir});
+                    }
+                }
+            }
+            auto lctx = getLocalContext(ctx);
+            lctx->finishStroke();
+            auto record = std::make_shared<HistoryRecord>(region->getDim());
+            auto count  = buffer.flush(*blockSource, record.get());
+            lctx->pushHistory(std::move(record));
+            ctx.success("{0} block(s) changed", count);
+        }
+    );
+};
+} // namespace we
@@ -0,0 +1,57 @@
+#include "command/CommandMacro.h"
+#include "world/BlockReplace.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/block/BlockLegacy.h>
+
+namespace we {
+REG_CMD(operation, rep, "replace a block with another in the region") {
+    struct Params {
+        CommandBlockName from;
+        CommandBlockName to;
+    };
+    command.overload<Params>().required("from").required("to").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, Params const& params) {
+            auto region = checkRegion(ctx);
+            if (!region) return;
+            auto blockSource = getBlockSource(region->getDim());
+            if (!blockSource) {
+                ctx.error("dimension of the region isn't loaded");
+                return;
+            }
+            auto from = params.from.resolveBlock(0).getBlock();
+            auto to   = params.to.resolveBlock(0).getBlock();
+            if (!from || !to) {
+                ctx.error("unknown block");
+                return;
+            }
+            auto box = region->getBoundingBox();
+            if (!checkUnlocked(ctx, region->getDim(), box)) {
+                return;
+            }
+            // a substitution per sub chunk, or with block entities a buffered
+            // entry per block
+            auto tiles = (uint64)((box.max.x >> 4) - (box.min.x >> 4) + 1)
+                       * ((box.max.y >> 4) - (box.min.y >> 4) + 1)
+                       * ((box.max.z >> 4) - (box.min.z >> 4) + 1);
+            auto bytes = tiles * sizeof(HistoryRecord::Substitution);
+            if (from->getLegacyBlock().hasBlockEntity()
+                || to->getLegacyBlock().hasBlockEntity()) {
+                bytes = EditBuffer::estimateMemory(region->size());
+            }
+            if (!checkMemory(ctx, bytes)) {
+                return;
+            }
+            auto lctx = getLocalContext(ctx);
+            lctx->finishStroke();
+            auto record = std::make_shared<HistoryRecord>(region->getDim());
+            auto count  = replaceBlocks(*blockSource, *region, *from, *to, *record);
+            lctx->pushHistory(std::move(record));
+            ctx.success("{0} block(s) changed", count);
+        }
+    );
+};
+} // namespace we
@@ -0,0 +1,116 @@
+#include "command/CommandMacro.h"
+#include "utils/Capsule.h"
+#include "utils/Catenary.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+// Samples a rope of the given length hanging from a to b, or the straight line
+// when it is too short to sag or hangs vertically.
+static void
+sampleRope(Vec3 const& a, Vec3 const& b, double length, std::vector<Vec3>& points) {
+    double dx = b.x - a.x, dz = b.z - a.z, h = b.y - a.y;
+    double d  = std::sqrt(dx * dx + dz * dz);
+    if (d < 1e-6 || length * length <= (d * d + h * h) * (1 + 1e-6)) {
+        points.push_back(b);
+        return;
+    }
+    double c = getCatenaryParameter(d, h, length);
+    // y(s) = c (cosh((s - s0) / c) - cosh(s0 / c)) passes through 0 at 0 and h at d
+    double s0    = d / 2 - c * std::asinh(h / (2 * c * std::sinh(d / (2 * c))));
+    int    count = std::max((int)std::ceil(length * 2), 1);
+    for (int i = 1; i <= count; i++) {
+        double s = d * i / count;
+        points.emplace_back(
+            a.x + dx * (s / d),
+            a.y + c * (std::cosh((s - s0) / c) - std::cosh(s0 / c)),
+            a.z + dz * (s / d)
+        );
+    }
+}
+
+REG_CMD(operation, rope, "hang ropes along the lines of the region") {
+    struct Params {
+        CommandBlockName block;
+        float            length{1.2f};
+        int              radius{};
+        struct VaArgs {
+            bool hollow{};
+        } args;
+    };
+    command.overload<Params>()
+        .required("block")
+        .optional("length")
+        .optional("radius")
+        .optional("args")
+        .execute(
+            CmdCtxBuilder{} |
+            [](CommandContextRef const& ctx, Params const& params) {
+                auto region = checkRegion(ctx);
+                if (!region) return;
+                auto blockSource = getBlockSource(region->getDim());
+                if (!blockSource) {
+                    ctx.error("dimension of the region isn't loaded");
+                    return;
+                }
+                auto block = params.block.resolveBlock(0).getBlock();
+                if (!block) {
+                    ctx.error("unknown block");
+                    return;
+                }
+                // a rope shorter than the distance of its ends is straight
+                int    radius = std::max(params.radius, 0);
+                uint64 blocks{};
+                region->forEachLine([&](BlockPos const& from, BlockPos const& to) {
+                    auto length  = from.center().distanceTo(to.center());
+                    length      *= std::max(params.length, 1.0f);
+                    blocks      += estimatePolylineBlocks(length, radius);
+                });
+                if (!checkMemory(ctx, estimateFillSetMemory(blocks))) {
+                    return;
+                }
+                auto box = region->getBoundingBox();
+                box.min  = box.min - radius;
+                box.max  = box.max + radius;
+                if (!checkUnlocked(ctx, region->getDim(), box)) {
+                    return;
+                }
+                // length is relative to the distance between the ends of each rope
+                SparseBlockSet set;
+                {
+                    OperationContext::PhaseScope phase{Phase::Evaluate};
+                    region->forEachLine([&](BlockPos const& from, BlockPos const& to) {
+                        std::vector<Vec3> points{from.center()};
+                        sampleRope(
+                            from.center(),
+                            to.center(),
+                            from.center().distanceTo(to.center()) * params.length,
+                            points
+                        );
+                        rasterizePolyline(set, points, radius);
+                    });
+                }
+                if (set.empty()) {
+                    ctx.error("region has no lines");
+                    return;
+                }
+                // the ropes sag below the box of their ends
+                if (!checkUnlocked(ctx, region->getDim(), set.getTileBox())) {
+                    return;
+                }
+                if (params.args.hollow) {
+                    set = set.shell();
+                }
+                auto lctx = getLocalContext(ctx);
+                lctx->finishStroke();
+                auto record = std::make_shared<HistoryRecord>(region->getDim());
+                auto count =
+                    fillSet(*blockSource, set, {block, BedrockBlocks::mAir}, record.get());
+                lctx->pushHistory(std::move(record));
+                ctx.success("{0} block(s) changed", count);
+            }
+        );
+};
+} // namespace we
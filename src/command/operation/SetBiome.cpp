@@ -0,0 +1,48 @@
+#include "command/CommandMacro.h"
+#include "world/BiomeEdit.h"
+
+#include <mc/world/level/biome/Biome.h>
+#include <mc/world/level/biome/registry/BiomeRegistry.h>
+
+namespace we {
+REG_CMD(operation, setbiome, "set the biome of the region") {
+    struct Params {
+        std::string biome;
+    };
+    command.overload<Params>().required("biome").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, Params const& params) {
+            auto region = checkRegion(ctx);
+            if (!region) return;
+            auto blockSource = getBlockSource(region->getDim());
+            if (!blockSource) {
+                ctx.error("dimension of the region isn't loaded");
+                return;
+            }
+            auto& registry = ll::service::getLevel()->getBiomeRegistry();
+            auto  biome    = registry.lookupByName(params.biome);
+            if (!biome) {
+                ctx.error("unknown biome {0}", params.biome);
+                return;
+            }
+            auto box = region->getBoundingBox();
+            if (!checkUnlocked(ctx, region->getDim(), box)) {
+                return;
+            }
+            // a change per sub chunk, its replaced biomes at up to a byte each
+            auto tiles = (uint64)((box.max.x >> 4) - (box.min.x >> 4) + 1)
+                       * ((box.max.y >> 4) - (box.min.y >> 4) + 1)
+                       * ((box.max.z >> 4) - (box.min.z >> 4) + 1);
+            if (!checkMemory(ctx, tiles * (sizeof(HistoryRecord::BiomeChange) + 4096))) {
+                return;
+            }
+            auto lctx = getLocalContext(ctx);
+            lctx->finishStroke();
+            auto record = std::make_shared<HistoryRecord>(region->getDim());
+            auto count  = setBiomes(*blockSource, *region, *biome, *record);
+            lctx->pushHistory(std::move(record));
+            ctx.success("biome of {0} block(s) changed", count);
+        }
+    );
+};
+} // namespace we
@@ -0,0 +1,73 @@
+#include "command/CommandMacro.h"
+#include "utils/SparseBlockSet.h"
+
+#include <mc/server/commands/CommandBlockName.h>
+#include <mc/server/commands/CommandBlockNameResult.h>
+#include <mc/world/level/BedrockBlocks.h>
+
+namespace we {
+struct SurfaceParams {
+    CommandBlockName block;
+};
+
+// Fills the blocks of the region forEachBlock visits, walls or faces.
+static void fillSurface(
+    CommandContextRef const& ctx,
+    SurfaceParams const&     params,
+    void (Region::*forEachBlock)(std::function<void(BlockPos const&)>&&) const
+) {
+    auto region = checkRegion(ctx);
+    if (!region) return;
+    auto blockSource = getBlockSource(region->getDim());
+    if (!blockSource) {
+        ctx.error("dimension of the region isn't loaded");
+        return;
+    }
+    auto block = params.block.resolveBlock(0).getBlock();
+    if (!block) {
+        ctx.error("unknown block");
+        return;
+    }
+    auto box = region->getBoundingBox();
+    if (!checkUnlocked(ctx, region->getDim(), box)) {
+        return;
+    }
+    // the record of up to the whole surface of the bounding box
+    auto side = box.getSideLength();
+    auto area =
+        (uint64)side.x * side.y + (uint64)side.y * side.z + (uint64)side.x * side.z;
+    if (!checkMemory(ctx, 2 * area * sizeof(HistoryRecord::Entry))) {
+        return;
+    }
+    SparseBlockSet surface;
+    {
+        OperationContext::PhaseScope phase{Phase::Iterate};
+        ((*region).*forEachBlock)([&](BlockPos const& pos) { surface.set(pos); });
+    }
+    auto lctx = getLocalContext(ctx);
+    lctx->finishStroke();
+    auto record = std::make_shared<HistoryRecord>(region->getDim());
+    auto count =
+        fillSet(*blockSource, surface, {block, BedrockBlocks::mAir}, record.get());
+    lctx->pushHistory(std::move(record));
+    ctx.success("{0} block(s) changed", count);
+}
+
+REG_CMD(operation, walls, "build walls along the sides of the region") {
+    command.overload<SurfaceParams>().required("block").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, SurfaceParams const& params) {
+            fillSurface(ctx, params, &Region::forEachBlockInWalls);
+        }
+    );
+};
+
+REG_CMD(operation, faces, "cover every face of the region") {
+    command.overload<SurfaceParams>().required("block").execute(
+        CmdCtxBuilder{} |
+        [](CommandContextRef const& ctx, SurfaceParams const& params) {
+            fillSurface(ctx, params, &Region::forEachBlockInFaces);
+        }
+    );
+};
+} // namespace we
@@ -27,6 +27,38 @@ struct Config {
             CmdSetting outset{};
             CmdSetting inset{};
         } region;
+        struct {
+            CmdSetting undo{};
+            CmdSetting redo{};
+        } history;
+        struct {
+            CmdSetting brush{};
+        } brush;
+        struct {
+            CmdSetting sphere{};
+            CmdSetting cyl{};
+            CmdSetting model{};
+        } generation;
+        struct {
+            CmdSetting hollow{};
+            CmdSetting gen{};
+            CmdSetting rep{};
+            CmdSetting line{};
+            CmdSetting curve{};
+            CmdSetting rope{};
+            CmdSetting move{};
+            CmdSetting walls{};
+            CmdSetting faces{};
+            CmdSetting overlay{};
+            CmdSetting naturalize{};
+            CmdSetting setbiome{};
+        } operation;
+        struct {
+            CmdSetting count{};
+            CmdSetting distr{};
+            CmdSetting perf{};
+            CmdSetting trace{};
+        } info;
     } commands{};
     struct {
         mce::Color region_line_color{"#FFEC27"};
@@ -41,11 +73,47 @@ struct Config {
     } player_state;
     struct {
         ll::io::LogLevel player_log_level{ll::io::LogLevel::Warn};
+        ll::io::LogLevel operation_log_level{ll::io::LogLevel::Debug};
+        ll::io::LogLevel slow_operation_log_level{ll::io::LogLevel::Warn};
+        uint64           slow_operation_ms{50};
+        size_t           player_operation_count{16};
+        size_t           server_operation_count{1024};
     } log;
+    struct {
+        uint64 stroke_idle_tick = 10;
+    } brush;
+    struct {
+        // edits estimated to need more than a limit are refused up front
+        size_t operation_limit_mb{1024};
+        size_t player_limit_mb{2048};
+        size_t server_limit_mb{8192};
+    } memory;
+    struct SchedulerConfig {
+        // blocks the scheduled edits write per tick all together; the budget
+        // starts at blocks_per_tick and adapts between the min and the max
+        size_t blocks_per_tick{32768};
+        size_t min_blocks_per_tick{1024};
+        size_t max_blocks_per_tick{1 << 20};
+        // it grows by this every tick it was used up and the server kept up,
+        size_t increase_blocks_per_tick{2048};
+        // and halves when writing took longer than write_ms_per_tick, or the
+        // server tick longer than lag_tick_ms
+        double write_ms_per_tick{10};
+        double lag_tick_ms{55};
+        // shares of the budget by the permission level of an edit's origin
+        struct {
+            uint any{1};
+            uint game_directors{2};
+            uint admin{4};
+            uint host{4};
+            uint owner{8};
+        } priority;
+    } scheduler;
 
     struct PlayerConfig {
         RegionType   default_region_type{RegionType::Expand};
         HashedString wand = VanillaItemNames::WoodenAxe();
+        size_t       max_history_length{20};
     } player_default_config;
 };
 } // namespace we
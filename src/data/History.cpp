@@ -0,0 +1,134 @@
+#include "History.h"
+#include "Telemetry.h"
+#include "world/BlockEntity.h"
+#include "world/ChunkSync.h"
+
+namespace we {
+static size_t
+apply(BlockSource& blockSource, HistoryRecord::Substitution const& sub, bool undo) {
+    auto&  block = undo ? *sub.oldBlock : *sub.newBlock;
+    size_t res{};
+    for (int i = 0; i < 4096; ++i) {
+        if (sub.mask[i]) {
+            res += setBlockLayer(blockSource, toBlockPos(sub.pos, i), sub.extra, block);
+        }
+    }
+    return res;
+}
+
+// Clients only see biomes when their chunk is sent again.
+template <class Changes>
+static phmap::flat_hash_set<ChunkPos> getBiomeChunks(Changes const& changes) {
+    phmap::flat_hash_set<ChunkPos> res;
+    for (auto& change : changes) {
+        res.insert(ChunkPos{change.pos.x, change.pos.z});
+    }
+    return res;
+}
+
+size_t HistoryRecord::size() const {
+    size_t res = entries.size();
+    for (auto& sub : substitutions) {
+        res += sub.mask.count();
+    }
+    for (auto& change : biomeChanges) {
+        res += change.mask.count();
+    }
+    return res;
+}
+
+BoundingBox HistoryRecord::getBoundingBox() const {
+    std::optional<BoundingBox> res;
+    auto add = [&](BoundingBox const& box) { res = res ? res->merge(box) : box; };
+    for (auto& entry : entries) {
+        add(entry.pos);
+    }
+    for (auto& sub : substitutions) {
+        add({toBlockPos(sub.pos, 0), toBlockPos(sub.pos, 4095)});
+    }
+    for (auto& change : biomeChanges) {
+        add({toBlockPos(change.pos, 0), toBlockPos(change.pos, 4095)});
+    }
+    return res.value_or(BoundingBox{});
+}
+
+size_t HistoryRecord::undo(BlockSource& blockSource) const {
+    OperationContext::PhaseScope phase{Phase::Write};
+    OperationContext::addTouched(size());
+    size_t res{};
+    for (auto& entry : entries | std::views::reverse) {
+        res += setBlockPair(blockSource, entry.pos, entry.oldBlocks);
+    }
+    for (auto& sub : substitutions | std::views::reverse) {
+        res += apply(blockSource, sub, true);
+    }
+    // backwards too, a block replaced twice ends with its first block entity
+    for (auto& [pos, nbt] : blockEntities | std::views::reverse) {
+        loadBlockEntity(blockSource, pos, nbt);
+    }
+    for (auto& change : biomeChanges | std::views::reverse) {
+        res += writeBiomes(blockSource, change.pos, change.mask, change.oldBiomes);
+    }
+    resendChunks(blockSource, getBiomeChunks(biomeChanges));
+    OperationContext::addWritten(res);
+    return res;
+}
+
+size_t HistoryRecord::redo(BlockSource& blockSource) const {
+    OperationContext::PhaseScope phase{Phase::Write};
+    OperationContext::addTouched(size());
+    size_t res{};
+    for (auto& change : biomeChanges) {
+        res += writeBiomes(blockSource, change.pos, change.mask, change.newBiomes);
+    }
+    resendChunks(blockSource, getBiomeChunks(biomeChanges));
+    for (auto& sub : substitutions) {
+        res += apply(blockSource, sub, false);
+    }
+    for (auto& entry : entries) {
+        res += setBlockPair(blockSource, entry.pos, entry.newBlocks);
+    }
+    for (auto& [pos, nbt] : placedBlockEntities) {
+        loadBlockEntity(blockSource, pos, nbt);
+    }
+    OperationContext::addWritten(res);
+    return res;
+}
+
+void History::push(std::shared_ptr<HistoryRecord> record, size_t maxLength) {
+    records.resize(applied);
+    if (maxLength == 0) {
+        applied = 0;
+        records.clear();
+        return;
+    }
+    records.push_back(std::move(record));
+    while (records.size() > maxLength) {
+        records.pop_front();
+    }
+    applied = records.size();
+}
+
+bool History::dropOldest() {
+    if (applied <= 1) {
+        return false;
+    }
+    records.pop_front();
+    --applied;
+    return true;
+}
+
+std::shared_ptr<HistoryRecord> History::undo() {
+    if (applied == 0) {
+        return nullptr;
+    }
+    return records[--applied];
+}
+
+std::shared_ptr<HistoryRecord> History::redo() {
+    if (applied == records.size()) {
+        return nullptr;
+    }
+    return records[applied++];
+}
+} // namespace we
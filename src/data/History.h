@@ -0,0 +1,122 @@
+#pragma once
+
+#include "data/SharedNbt.h"
+#include "world/BiomeEdit.h"
+#include "world/EditBuffer.h"
+#include "worldedit/Global.h"
+
+#include <bitset>
+
+namespace we {
+// One undoable edit: the blocks it replaced and what it wrote, in write order.
+class HistoryRecord {
+public:
+    struct Entry {
+        BlockPos  pos;
+        BlockPair oldBlocks;
+        BlockPair newBlocks;
+    };
+
+    // One block swapped for another on one layer of a sub chunk, at the
+    // storage indices set in mask; far smaller than an Entry per block.
+    struct Substitution {
+        SubChunkPos       pos;
+        bool              extra;
+        Block const*      oldBlock;
+        Block const*      newBlock;
+        std::bitset<4096> mask;
+    };
+
+    // Biomes set over one sub chunk at the storage indices set in mask, the
+    // replaced ones palette compressed.
+    struct BiomeChange {
+        SubChunkPos       pos;
+        std::bitset<4096> mask;
+        SubChunkBiomes    oldBiomes;
+        SubChunkBiomes    newBiomes;
+    };
+
+    // The block entity of a block a write replaced, loaded back on undo, or
+    // one an edit loaded into a block it wrote, loaded again on redo.
+    struct BlockEntity {
+        BlockPos  pos;
+        SharedNbt nbt;
+    };
+
+private:
+    DimensionType                                        dim;
+    TrackedVector<Entry, MemoryCategory::History>        entries;
+    TrackedVector<Substitution, MemoryCategory::History> substitutions;
+    TrackedVector<BlockEntity, MemoryCategory::History>  blockEntities;
+    TrackedVector<BlockEntity, MemoryCategory::History>  placedBlockEntities;
+    TrackedVector<BiomeChange, MemoryCategory::History>  biomeChanges;
+
+public:
+    explicit HistoryRecord(DimensionType dim) : dim(dim) {}
+
+    DimensionType getDim() const { return dim; }
+
+    size_t size() const;
+
+    // Bounds of the blocks the record changes, sub chunk aligned where it
+    // holds substitutions or biome changes. Meaningless when empty.
+    BoundingBox getBoundingBox() const;
+
+    bool empty() const {
+        return entries.empty() && substitutions.empty() && biomeChanges.empty();
+    }
+
+    void add(BlockPos const& pos, BlockPair const& oldBlocks, BlockPair const& newBlocks) {
+        entries.emplace_back(pos, oldBlocks, newBlocks);
+    }
+
+    // A record shouldn't hold both an entry and a substitution for one block.
+    void add(Substitution substitution) {
+        if (substitution.mask.any()) {
+            substitutions.push_back(std::move(substitution));
+        }
+    }
+
+    void add(BlockPos const& pos, SharedNbt nbt) {
+        blockEntities.emplace_back(pos, std::move(nbt));
+    }
+
+    void addPlaced(BlockPos const& pos, SharedNbt nbt) {
+        placedBlockEntities.emplace_back(pos, std::move(nbt));
+    }
+
+    void add(BiomeChange change) {
+        if (change.mask.any()) {
+            biomeChanges.push_back(std::move(change));
+        }
+    }
+
+    size_t undo(BlockSource&) const;
+
+    size_t redo(BlockSource&) const;
+};
+
+class History {
+    std::deque<std::shared_ptr<HistoryRecord>> records;
+    size_t                                     applied{};
+
+public:
+    // Drops the redo branch and the oldest records beyond maxLength.
+    void push(std::shared_ptr<HistoryRecord> record, size_t maxLength);
+
+    // Drops the oldest undoable record, keeping the latest. False if there is
+    // none to drop.
+    bool dropOldest();
+
+    // The record to revert, nullptr if there is nothing to undo.
+    std::shared_ptr<HistoryRecord> undo();
+
+    // The record to reapply, nullptr if there is nothing to redo.
+    std::shared_ptr<HistoryRecord> redo();
+
+    void clear() {
+        records.clear();
+        applied = 0;
+    }
+};
+} // namespace we
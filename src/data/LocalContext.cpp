@@ -11,7 +11,8 @@ LocalContext::LocalContext(mce::UUID const& uuid, bool temp)
 
 void LocalContext::setMainPosInternal() {
     if (mainPos) {
-        auto& we     = WorldEdit::getInstance();
+        OperationContext::PhaseScope phase{Phase::Geometry};
+        auto&                        we = WorldEdit::getInstance();
         mainPos->geo = we.getGeo().box(
             mainPos->data.dim,
             AABB{mainPos->data.pos}.shrink(-0.07f),
@@ -21,7 +22,8 @@ void LocalContext::setMainPosInternal() {
 }
 void LocalContext::setOffPosInternal() {
     if (offPos) {
-        auto& we    = WorldEdit::getInstance();
+        OperationContext::PhaseScope phase{Phase::Geometry};
+        auto&                        we = WorldEdit::getInstance();
         offPos->geo = we.getGeo().box(
             offPos->data.dim,
             AABB{offPos->data.pos}.shrink(-0.06f),
@@ -37,7 +39,16 @@ Region& LocalContext::getOrCreateRegion(WithDim<BlockPos> const& v) {
     }
     return *region;
 }
+bool LocalContext::isRegionInUse() const {
+    return WorldEdit::getInstance().getScheduler().hasJobs(uuid);
+}
 bool LocalContext::setMainPos(WithDim<BlockPos> const& v) {
+    if (isRegionInUse()) {
+        return false;
+    }
+    MemoryAccount::Scope account{memory};
+    // regions redraw themselves as they change
+    OperationContext::PhaseScope phase{Phase::Geometry};
     if (auto& r = getOrCreateRegion(v); r.setMainPos(v.pos)) {
         mainPos.emplace(v);
         setMainPosInternal();
@@ -49,6 +60,11 @@ bool LocalContext::setMainPos(WithDim<BlockPos> const& v) {
     return false;
 }
 bool LocalContext::setOffPos(WithDim<BlockPos> const& v) {
+    if (isRegionInUse()) {
+        return false;
+    }
+    MemoryAccount::Scope         account{memory};
+    OperationContext::PhaseScope phase{Phase::Geometry};
     if (getOrCreateRegion(v).setOffPos(v.pos)) {
         offPos.emplace(v);
         setOffPosInternal();
@@ -57,6 +73,54 @@ bool LocalContext::setOffPos(WithDim<BlockPos> const& v) {
     return false;
 }
 
+void LocalContext::applyBrush(
+    std::shared_ptr<Brush> const& brush,
+    WithDim<BlockPos> const&      v,
+    uint64                        tick
+) {
+    MemoryAccount::Scope account{memory};
+    OperationContext     operation{"brush"};
+    if (!stroke
+        || !stroke->canContinue(
+            *brush,
+            v.dim,
+            tick,
+            WorldEdit::getInstance().getConfig().brush.stroke_idle_tick
+        )) {
+        finishStroke();
+        stroke = std::make_shared<BrushStroke>(uuid, brush, v.dim, tick);
+    }
+    stroke->apply(v.pos, tick);
+    if (auto stats = operation.finish(); !stats.empty()) {
+        recordOperation(std::move(stats));
+    }
+}
+void LocalContext::finishStroke() {
+    if (!stroke) {
+        return;
+    }
+    stroke->flush();
+    pushHistory(stroke->getRecord());
+    stroke.reset();
+}
+void LocalContext::pushHistory(std::shared_ptr<HistoryRecord> record) {
+    if (record->empty()) {
+        return;
+    }
+    history.push(std::move(record), config.max_history_length);
+    // make room for the next edits, they are refused once the player is over
+    auto limit = WorldEdit::getInstance().getConfig().memory.player_limit_mb << 20;
+    while (memory->total() > (int64)limit && history.dropOldest()) {}
+}
+void LocalContext::recordOperation(OperationStats stats) {
+    auto& we = WorldEdit::getInstance();
+    we.recordOperation(stats);
+    operations.push_back(std::move(stats));
+    while (operations.size() > we.getConfig().log.player_operation_count) {
+        operations.pop_front();
+    }
+}
+
 ll::Expected<> LocalContext::serialize(CompoundTag& nbt) const noexcept try {
     return ll::reflection::serialize_to(nbt["config"], config)
         .and_then([&, this]() {
@@ -81,6 +145,7 @@ ll::Expected<> LocalContext::serialize(CompoundTag& nbt) const noexcept try {
     return ll::makeExceptionError();
 }
 ll::Expected<> LocalContext::deserialize(CompoundTag const& nbt) noexcept try {
+    MemoryAccount::Scope account{memory};
     return ll::reflection::deserialize(config, nbt["config"])
         .and_then([&, this]() {
             ll::Expected<> res;
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Config.h"
+#include "History.h"
+#include "Telemetry.h"
+#include "brush/BrushStroke.h"
 #include "region/Region.h"
 
 #include <mc/platform/UUID.h>
@@ -27,12 +30,41 @@ public:
     std::optional<RegionType>                 regionType;
     std::shared_ptr<Region>                   region;
     Config::PlayerConfig                      config;
+    History                                   history;
+
+    phmap::flat_hash_map<HashedString, std::shared_ptr<Brush>> brushes;
+    std::shared_ptr<BrushStroke>                               stroke;
+
+    std::deque<OperationStats> operations;
+
+    // What the history, region and edits of this player hold.
+    std::shared_ptr<MemoryAccount> memory = std::make_shared<MemoryAccount>();
 
     LocalContext(mce::UUID const& uuid, bool temp);
 
+    mce::UUID const& getUuid() const { return uuid; }
+
+    // Whether a scheduled edit of the player still reads the region, which
+    // can't change until the edit is done.
+    bool isRegionInUse() const;
+
+    // Both fail while the region is in use.
     bool setMainPos(WithDim<BlockPos> const&);
     bool setOffPos(WithDim<BlockPos> const&);
 
+    void applyBrush(std::shared_ptr<Brush> const&, WithDim<BlockPos> const&, uint64 tick);
+
+    // Flushes the current stroke and records it in the history.
+    void finishStroke();
+
+    // Records a finished edit, empty records are dropped. The oldest records
+    // go once the player holds more than memory.player_limit_mb.
+    void pushHistory(std::shared_ptr<HistoryRecord> record);
+
+    // Keeps the stats of a finished operation among the player's latest, and
+    // hands them to the server telemetry.
+    void recordOperation(OperationStats stats);
+
     ll::Expected<> serialize(CompoundTag&) const noexcept;
     ll::Expected<> deserialize(CompoundTag const&) noexcept;
 };
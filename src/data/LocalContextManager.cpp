@@ -1,4 +1,5 @@
 #include "LocalContextManager.h"
+#include "utils/Trace.h"
 #include "worldedit/WorldEdit.h"
 
 #include <ll/api/event/EventBus.h>
@@ -163,6 +164,7 @@ LocalContextManager::~LocalContextManager() {
         if (p.second->temp) {
             return;
         }
+        trace::Span span{"LocalContextManager::save"};
         CompoundTag nbt;
         p.second->serialize(nbt);
         storagedState.set(p.first.asString(), nbt.toBinaryNbt());
@@ -173,6 +175,7 @@ std::shared_ptr<LocalContext> LocalContextManager::get(mce::UUID const& uuid, bo
     if (playerStates.if_contains(uuid, [&](auto&& p) { res = p.second; })) {
         return res;
     } else if (!temp) {
+        trace::Span span{"LocalContextManager::load"};
         if (auto nbt = storagedState.get(uuid.asString()); nbt) {
             res = std::make_shared<LocalContext>(uuid, temp);
             CompoundTag::fromBinaryNbt(*nbt).and_then([&](CompoundTag&& tag) {
@@ -192,6 +195,7 @@ LocalContextManager::getOrCreate(mce::UUID const& uuid, bool temp) {
         [&, this](auto&& ctor) {
             res = std::make_shared<LocalContext>(uuid, temp);
             if (!temp) {
+                trace::Span span{"LocalContextManager::load"};
                 if (auto nbt = storagedState.get(uuid.asString()); nbt) {
                     CompoundTag::fromBinaryNbt(*nbt).and_then([&](CompoundTag&& tag) {
                         return res->deserialize(tag);
@@ -231,6 +235,7 @@ bool LocalContextManager::release(mce::UUID const& uuid) {
         if (p.second->temp) {
             return true;
         }
+        trace::Span span{"LocalContextManager::save"};
         CompoundTag nbt;
         p.second->serialize(nbt);
         return storagedState.set(uuid.asString(), nbt.toBinaryNbt());
@@ -306,6 +311,10 @@ LocalContextManager::ClickState LocalContextManager::playerRightClick(
         }
         return ClickState::Hold;
     }
+    if (auto iter = data->brushes.find(itemName); iter != data->brushes.end()) {
+        data->applyBrush(iter->second, dst, current.tickID);
+        return ClickState::Hold;
+    }
     return ClickState::Pass;
 }
 
@@ -0,0 +1,77 @@
+#include "SharedNbt.h"
+#include "utils/TrackedAllocator.h"
+
+#include <mutex>
+
+namespace we {
+struct SharedNbt::Entry {
+    std::string binary;
+};
+
+namespace {
+// The live entries by content. An entry leaves when its last handle goes,
+// unless an equal tag was interned again meanwhile.
+struct Pool {
+    std::mutex                                                        mutex;
+    phmap::flat_hash_map<std::string_view, std::weak_ptr<void const>> entries;
+    size_t                                                            bytes{};
+};
+
+Pool& pool() {
+    static Pool res;
+    return res;
+}
+} // namespace
+
+SharedNbt SharedNbt::intern(std::string binary) {
+    auto& [mutex, entries, bytes] = pool();
+    std::lock_guard lock{mutex};
+    if (auto iter = entries.find(binary); iter != entries.end()) {
+        if (auto live = iter->second.lock()) {
+            SharedNbt res;
+            res.entry = std::static_pointer_cast<Entry const>(live);
+            return res;
+        }
+        // its last handle is going, the key views the binary it frees
+        entries.erase(iter);
+    }
+    auto size = (int64)(sizeof(Entry) + binary.capacity());
+    SharedNbt res;
+    res.entry = std::shared_ptr<Entry const>(
+        new Entry{std::move(binary)},
+        [size](Entry const* entry) {
+            auto& [mutex, entries, bytes] = pool();
+            {
+                std::lock_guard lock{mutex};
+                if (auto iter = entries.find(entry->binary);
+                    iter != entries.end() && iter->second.expired()) {
+                    entries.erase(iter);
+                }
+                bytes -= size;
+            }
+            MemoryAccount::server().charge(MemoryCategory::History, -size);
+            delete entry;
+        }
+    );
+    entries.emplace(res.entry->binary, res.entry);
+    bytes += size;
+    MemoryAccount::server().charge(MemoryCategory::History, size);
+    return res;
+}
+
+size_t SharedNbt::getUniqueCount() {
+    auto&           p = pool();
+    std::lock_guard lock{p.mutex};
+    return p.entries.size();
+}
+
+size_t SharedNbt::getUniqueBytes() {
+    auto&           p = pool();
+    std::lock_guard lock{p.mutex};
+    return p.bytes;
+}
+
+std::string_view SharedNbt::getBinary() const {
+    return entry ? std::string_view{entry->binary} : std::string_view{};
+}
+} // namespace we
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+namespace we {
+// Block entity NBT in its binary form, interned by content: every handle to an
+// equal tag shares one immutable copy, hashed once when it's interned. Copying
+// a handle is a refcount, so records full of identical chests or signs hold
+// their tag once however many copies of them there are.
+class SharedNbt {
+    struct Entry;
+
+    std::shared_ptr<Entry const> entry;
+
+public:
+    SharedNbt() = default;
+
+    static SharedNbt intern(std::string binary);
+
+    // Distinct tags interned and alive, and the bytes they hold.
+    static size_t getUniqueCount();
+    static size_t getUniqueBytes();
+
+    std::string_view getBinary() const;
+
+    explicit operator bool() const { return entry != nullptr; }
+
+    // Equal content is one entry, so this compares the tags.
+    bool operator==(SharedNbt const&) const = default;
+};
+} // namespace we
@@ -0,0 +1,99 @@
+#include "Telemetry.h"
+
+namespace we {
+thread_local OperationContext* OperationContext::currentContext{};
+
+std::string_view getPhaseName(Phase phase) {
+    switch (phase) {
+    case Phase::Iterate:
+        return "iterate";
+    case Phase::Evaluate:
+        return "evaluate";
+    case Phase::Capture:
+        return "capture";
+    case Phase::Write:
+        return "write";
+    case Phase::Geometry:
+        return "geometry";
+    default:
+        std::unreachable();
+    }
+}
+
+double OperationStats::blocksPerSecond() const {
+    auto seconds = std::chrono::duration<double>(total).count();
+    if (seconds <= 0) {
+        return 0;
+    }
+    return (double)(blocksWritten ? blocksWritten : blocksTouched) / seconds;
+}
+
+void OperationStats::merge(OperationStats const& other) {
+    for (size_t i = 0; i < phaseCount; ++i) {
+        phases[i] += other.phases[i];
+    }
+    total         += other.total;
+    blocksTouched += other.blocksTouched;
+    blocksWritten += other.blocksWritten;
+    chunkLookups  += other.chunkLookups;
+    peakMemory     = std::max(peakMemory, other.peakMemory);
+    arenaBytes    += other.arenaBytes;
+    allocations   += other.allocations;
+}
+
+OperationContext::OperationContext(std::string name)
+: start(Clock::now()),
+  previous(currentContext) {
+    stats.name     = std::move(name);
+    currentContext = this;
+}
+
+OperationContext::~OperationContext() { currentContext = previous; }
+
+OperationStats OperationContext::finish() const {
+    auto res        = stats;
+    res.total       = Clock::now() - start;
+    res.arenaBytes  = temporaries.getUsed();
+    res.allocations = temporaries.getAllocations();
+    return res;
+}
+
+void Telemetry::record(OperationStats const& stats) {
+    // nothing to take a rate of, selections and lookups would only skew it
+    if (stats.blocksTouched == 0) {
+        return;
+    }
+    count++;
+    operations.push_back(stats);
+    while (operations.size() > capacity) {
+        operations.pop_front();
+    }
+}
+
+Telemetry::Summary Telemetry::summarize() const {
+    Summary res;
+    res.count   = count;
+    res.samples = operations.size();
+    if (operations.empty()) {
+        return res;
+    }
+    std::vector<double> rates;
+    rates.reserve(operations.size());
+    for (auto& op : operations) {
+        rates.push_back(op.blocksPerSecond());
+        res.total         += op.total;
+        res.blocksWritten += op.blocksWritten;
+        for (size_t i = 0; i < phaseCount; ++i) {
+            res.phases[i] += op.phases[i];
+        }
+    }
+    auto percentile = [&](double p) {
+        auto nth = rates.begin() + (ptrdiff_t)((double)(rates.size() - 1) * p);
+        std::ranges::nth_element(rates, nth);
+        return *nth;
+    };
+    res.p50 = percentile(0.5);
+    res.p99 = percentile(0.01);
+    return res;
+}
+} // namespace we
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "utils/Arena.h"
+#include "utils/Trace.h"
+#include "worldedit/Global.h"
+
+#include <chrono>
+
+namespace we {
+// Where an edit spends its time. Block change packets are queued by the
+// writes themselves, so sending them counts as Write.
+enum class Phase : uchar {
+    Iterate,  // walking the region for the blocks to edit
+    Evaluate, // computing the blocks to write
+    Capture,  // reading and recording the replaced blocks
+    Write,    // setting blocks in the world
+    Geometry, // drawing selections
+};
+
+inline constexpr size_t phaseCount = 5;
+
+// A literal, so it names trace spans too.
+std::string_view getPhaseName(Phase);
+
+// Measurements of one edit operation.
+struct OperationStats {
+    using Duration = std::chrono::nanoseconds;
+
+    std::string                      name;
+    std::array<Duration, phaseCount> phases{};
+    Duration                         total{};
+    uint64                           blocksTouched{};
+    uint64                           blocksWritten{};
+    uint64                           chunkLookups{}; // chunks fetched, not block accesses
+    size_t                           peakMemory{};
+    size_t                           arenaBytes{};  // temporaries on the arena
+    size_t                           allocations{}; // arena blocks newly allocated
+
+    bool empty() const {
+        return blocksTouched == 0 && blocksWritten == 0
+            && std::ranges::all_of(phases, [](auto d) { return d == Duration{}; });
+    }
+
+    // Blocks written per second of the whole operation, touched if none were.
+    double blocksPerSecond() const;
+
+    // Adds the work of another part of the same operation, one run on another
+    // thread or tick. The total becomes the time worked, not the time waited.
+    void merge(OperationStats const&);
+};
+
+// Instruments the operation running on this thread. Engine code reports into
+// the innermost live context through the static functions, which do nothing
+// outside an operation, so uninstrumented callers only pay a branch.
+class OperationContext {
+public:
+    class PhaseScope;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    static thread_local OperationContext* currentContext;
+
+    OperationStats    stats;
+    Clock::time_point start;
+    OperationContext* previous;
+    PhaseScope*       scope{};
+    OperationArena    temporaries;
+
+public:
+    // Times one phase of the current operation until it goes out of scope.
+    // A nested scope pauses the enclosing one, so phases never overlap. It is
+    // a trace span too, inside an operation or not.
+    class PhaseScope {
+        trace::Span       span;
+        OperationContext* context;
+        PhaseScope*       parent{};
+        Phase             phase;
+        Clock::time_point start;
+
+        void stop(Clock::time_point now) {
+            context->stats.phases[(size_t)phase] += now - start;
+        }
+
+    public:
+        explicit PhaseScope(Phase phase)
+        : span(getPhaseName(phase).data()),
+          context(currentContext),
+          phase(phase) {
+            if (!context) {
+                return;
+            }
+            start  = Clock::now();
+            parent = std::exchange(context->scope, this);
+            if (parent) {
+                parent->stop(start);
+            }
+        }
+
+        PhaseScope(PhaseScope const&)            = delete;
+        PhaseScope& operator=(PhaseScope const&) = delete;
+
+        ~PhaseScope() {
+            if (!context) {
+                return;
+            }
+            auto now = Clock::now();
+            stop(now);
+            if ((context->scope = parent)) {
+                parent->start = now;
+            }
+        }
+    };
+
+    explicit OperationContext(std::string name);
+
+    OperationContext(OperationContext const&)            = delete;
+    OperationContext& operator=(OperationContext const&) = delete;
+
+    ~OperationContext();
+
+    static OperationContext* current() { return currentContext; }
+
+    // Where the operation running on this thread keeps its temporaries, the
+    // default resource outside one. Only for containers that stay on this
+    // thread and go before the operation does.
+    static std::pmr::memory_resource* arena() {
+        return currentContext ? &currentContext->temporaries
+                              : std::pmr::get_default_resource();
+    }
+
+    static void addTouched(uint64 n) {
+        if (currentContext) currentContext->stats.blocksTouched += n;
+    }
+
+    static void addWritten(uint64 n) {
+        if (currentContext) currentContext->stats.blocksWritten += n;
+    }
+
+    static void addChunkLookups(uint64 n) {
+        if (currentContext) currentContext->stats.chunkLookups += n;
+    }
+
+    // Reports memory the operation holds on top of the world right now,
+    // keeping the peak.
+    static void noteMemory(size_t bytes) {
+        if (currentContext) {
+            auto& peak = currentContext->stats.peakMemory;
+            peak       = std::max(peak, bytes);
+        }
+    }
+
+    // The stats so far, with the total time up to now.
+    OperationStats finish() const;
+};
+
+// The latest operations of the whole server, for throughput percentiles.
+class Telemetry {
+    std::deque<OperationStats> operations;
+    size_t                     capacity;
+    uint64                     count{};
+
+public:
+    struct Summary {
+        uint64                                           count{};   // since start
+        size_t                                           samples{}; // summarized below
+        double                                           p50{};     // blocks per second
+        double                                           p99{};
+        OperationStats::Duration                         total{};
+        std::array<OperationStats::Duration, phaseCount> phases{};
+        uint64                                           blocksWritten{};
+    };
+
+    explicit Telemetry(size_t capacity = 1024) : capacity(capacity) {}
+
+    void record(OperationStats const&);
+
+    // p99 is of the slowest, the 1% of samples with the lowest throughput.
+    Summary summarize() const;
+};
+} // namespace we
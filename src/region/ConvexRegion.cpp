@@ -1,5 +1,6 @@
 #include "ConvexRegion.h"
 #include "utils/Serialize.h"
+#include "utils/Trace.h"
 #include "worldedit/WorldEdit.h"
 
 namespace we {
@@ -114,15 +115,15 @@ void ConvexRegion::updateEdges() {
 }
 
 bool ConvexRegion::containsRaw(BlockPos const& pt) const {
-    if (lastTriangle && lastTriangle->above(pt)) {
+    // The triangle that last rejected a block on this thread likely rejects its
+    // neighbours too. Only a hint, so every region shares it and threads don't.
+    static thread_local size_t last{};
+    if (last < triangles.size() && triangles[last].above(pt)) {
         return false;
     }
-    for (auto& triangle : triangles) {
-        if (lastTriangle == triangle) {
-            continue;
-        }
-        if (triangle.above(pt)) {
-            lastTriangle = triangle;
+    for (size_t i = 0; i < triangles.size(); ++i) {
+        if (i != last && triangles[i].above(pt)) {
+            last = i;
             return false;
         }
     }
@@ -130,7 +131,7 @@ bool ConvexRegion::containsRaw(BlockPos const& pt) const {
 }
 
 bool ConvexRegion::addVertex(BlockPos const& vertex) {
-    lastTriangle = std::nullopt;
+    trace::Span span{"ConvexRegion::addVertex"};
     if (vertices.contains(vertex)) {
         return false;
     }
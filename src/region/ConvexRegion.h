@@ -20,8 +20,6 @@ class ConvexRegion : public Region {
 
     ll::math::longlong3 centerAccum;
 
-    mutable std::optional<Triangle> lastTriangle;
-
     std::vector<WithGeo<BlockPos>> indexedVertices;
 
 public:
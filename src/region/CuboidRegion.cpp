@@ -162,4 +162,37 @@ void CuboidRegion::forEachLine(
 ) const {
     todo(mainPos, offPos);
 }
+
+// The rim of every layer, with faces the whole bottom and top layers.
+static void forEachBoxSurface(
+    BoundingBox const&                          box,
+    bool                                        faces,
+    std::function<void(BlockPos const&)> const& todo
+) {
+    auto& min = box.min;
+    auto& max = box.max;
+    for (int y = min.y; y <= max.y; ++y) {
+        bool cap = faces && (y == min.y || y == max.y);
+        for (int z = min.z; z <= max.z; ++z) {
+            if (cap || z == min.z || z == max.z) {
+                for (int x = min.x; x <= max.x; ++x) {
+                    todo({x, y, z});
+                }
+                continue;
+            }
+            todo({min.x, y, z});
+            if (max.x != min.x) {
+                todo({max.x, y, z});
+            }
+        }
+    }
+}
+
+void CuboidRegion::forEachBlockInWalls(std::function<void(BlockPos const&)>&& todo) const {
+    forEachBoxSurface(boundingBox, false, todo);
+}
+
+void CuboidRegion::forEachBlockInFaces(std::function<void(BlockPos const&)>&& todo) const {
+    forEachBoxSurface(boundingBox, true, todo);
+}
 } // namespace we
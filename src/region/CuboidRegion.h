@@ -33,6 +33,14 @@ public:
 
     bool setOffPos(BlockPos const&) override;
 
+    bool containsBox(BoundingBox const& box) const override {
+        return boundingBox.contains(box.min) && boundingBox.contains(box.max);
+    }
+
+    void forEachBlockInWalls(std::function<void(BlockPos const&)>&&) const override;
+
+    void forEachBlockInFaces(std::function<void(BlockPos const&)>&&) const override;
+
     void forEachLine(std::function<void(BlockPos const&, BlockPos const&)>&& todo
     ) const override;
 };
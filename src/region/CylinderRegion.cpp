@@ -197,4 +197,12 @@ bool CylinderRegion::shift(BlockPos const& change) {
     updateBoundingBox();
     return true;
 }
+
+void CylinderRegion::forEachBlockInWalls(std::function<void(BlockPos const&)>&& todo) const {
+    forEachPrismBlock(minY, maxY, false, todo);
+}
+
+void CylinderRegion::forEachBlockInFaces(std::function<void(BlockPos const&)>&& todo) const {
+    forEachPrismBlock(minY, maxY, true, todo);
+}
 } // namespace we
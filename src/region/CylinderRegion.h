@@ -46,5 +46,9 @@ public:
     bool setOffPos(BlockPos const&) override;
 
     bool contains(BlockPos const&) const override;
+
+    void forEachBlockInWalls(std::function<void(BlockPos const&)>&&) const override;
+
+    void forEachBlockInFaces(std::function<void(BlockPos const&)>&&) const override;
 };
 } // namespace we
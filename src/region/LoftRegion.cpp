@@ -1,6 +1,7 @@
 #include "LoftRegion.h"
 #include "utils/Math.h"
 #include "utils/Serialize.h"
+#include "utils/Trace.h"
 #include "worldedit/WorldEdit.h"
 
 namespace we {
@@ -174,6 +175,7 @@ void LoftRegion::buildCache() const {
     if (interpolations.size() == 0) {
         return;
     }
+    trace::Span span{"LoftRegion::buildCache"};
     posCached = true;
     posCache.clear();
     double maxCurveLength = 0;
@@ -206,6 +208,7 @@ BoundingBox LoftRegion::getBoundingBox() const {
 
 void LoftRegion::forEachBlockInRegion(std::function<void(BlockPos const&)>&& todo) const {
     buildCache();
+    trace::Span span{"LoftRegion::forEachBlockInRegion"};
     for (auto& pos : posCache) {
         todo(pos.first);
     }
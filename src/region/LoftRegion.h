@@ -2,6 +2,7 @@
 
 #include "Region.h"
 #include "utils/Bresenham.h"
+#include "utils/TrackedAllocator.h"
 
 namespace we {
 
@@ -15,9 +16,12 @@ class LoftRegion : public Region {
 
     GeoContainer views;
 
-    mutable phmap::flat_hash_map<BlockPos, std::pair<double, double>> posCache;
-    mutable bool                                                      posCached = false;
-    mutable BoundingBox                                               boundingBox;
+    using PosCache =
+        TrackedHashMap<BlockPos, std::pair<double, double>, MemoryCategory::RegionCache>;
+
+    mutable PosCache    posCache;
+    mutable bool        posCached = false;
+    mutable BoundingBox boundingBox;
 
     static constexpr int quality = 16;
 
@@ -230,9 +230,10 @@ bool PolyRegion::contains(BlockPos const& pos) const {
     }
     bool inside = false;
 
-    auto lastPoint = points.front();
+    auto lastPoint = points.back();
     for (auto& point : points) {
-        if (lastPoint == point) {
+        // a vertex is on the boundary
+        if (point.x == pos.x && point.z == pos.z) {
             return true;
         }
         int x1;
@@ -265,4 +266,12 @@ bool PolyRegion::contains(BlockPos const& pos) const {
     }
     return inside;
 }
+
+void PolyRegion::forEachBlockInWalls(std::function<void(BlockPos const&)>&& todo) const {
+    forEachPrismBlock(minY, maxY, false, todo);
+}
+
+void PolyRegion::forEachBlockInFaces(std::function<void(BlockPos const&)>&& todo) const {
+    forEachPrismBlock(minY, maxY, true, todo);
+}
 } // namespace we
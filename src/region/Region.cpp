@@ -7,6 +7,7 @@
 #include "PolyRegion.h"
 #include "SphereRegion.h"
 #include "utils/Serialize.h"
+#include "utils/Trace.h"
 
 namespace we {
 
@@ -21,12 +22,77 @@ ll::Expected<> Region::serialize(CompoundTag& tag) const {
 ll::Expected<> Region::deserialize(CompoundTag const&) { return {}; }
 
 void Region::forEachBlockInRegion(std::function<void(BlockPos const&)>&& todo) const {
+    trace::Span span{"Region::forEachBlockInRegion"};
     for (auto&& pos : boundingBox.forEachPos()) {
         if (contains(pos)) {
             todo(pos);
         }
     }
 }
+void Region::forEachBlockInWalls(std::function<void(BlockPos const&)>&& todo) const {
+    forEachBlockInRegion([&](BlockPos const& pos) {
+        if (!contains(pos + BlockPos{1, 0, 0}) || !contains(pos - BlockPos{1, 0, 0})
+            || !contains(pos + BlockPos{0, 0, 1}) || !contains(pos - BlockPos{0, 0, 1})) {
+            todo(pos);
+        }
+    });
+}
+void Region::forEachBlockInFaces(std::function<void(BlockPos const&)>&& todo) const {
+    forEachBlockInRegion([&](BlockPos const& pos) {
+        if (!contains(pos + BlockPos{1, 0, 0}) || !contains(pos - BlockPos{1, 0, 0})
+            || !contains(pos + BlockPos{0, 1, 0}) || !contains(pos - BlockPos{0, 1, 0})
+            || !contains(pos + BlockPos{0, 0, 1}) || !contains(pos - BlockPos{0, 0, 1})) {
+            todo(pos);
+        }
+    });
+}
+void Region::forEachPrismBlock(
+    int                                         minY,
+    int                                         maxY,
+    bool                                        faces,
+    std::function<void(BlockPos const&)> const& todo
+) const {
+    trace::Span span{"Region::forEachPrismBlock"};
+    if (minY > maxY) {
+        return;
+    }
+    // the layer with a border of outside blocks
+    int               minX  = boundingBox.min.x - 1;
+    int               minZ  = boundingBox.min.z - 1;
+    int               sizeX = boundingBox.max.x - minX + 2;
+    int               sizeZ = boundingBox.max.z - minZ + 2;
+    std::vector<bool> inside((size_t)sizeX * sizeZ);
+    for (int z = 1; z < sizeZ - 1; ++z) {
+        for (int x = 1; x < sizeX - 1; ++x) {
+            inside[(size_t)z * sizeX + x] = contains({minX + x, minY, minZ + z});
+        }
+    }
+    std::vector<Pos2d> rim, caps;
+    for (int z = 1; z < sizeZ - 1; ++z) {
+        for (int x = 1; x < sizeX - 1; ++x) {
+            auto i = (size_t)z * sizeX + x;
+            if (!inside[i]) {
+                continue;
+            }
+            if (!inside[i - 1] || !inside[i + 1] || !inside[i - sizeX]
+                || !inside[i + sizeX]) {
+                rim.push_back({minX + x, minZ + z});
+            } else if (faces) {
+                caps.push_back({minX + x, minZ + z});
+            }
+        }
+    }
+    for (int y = minY; y <= maxY; ++y) {
+        for (auto& p : rim) {
+            todo({p.x, y, p.z});
+        }
+        if (y == minY || y == maxY) {
+            for (auto& p : caps) {
+                todo({p.x, y, p.z});
+            }
+        }
+    }
+}
 void Region::forEachBlockUVInRegion(
     std::function<void(BlockPos const&, double, double)>&& todo
 ) const {
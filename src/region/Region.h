@@ -14,6 +14,16 @@ protected:
 
     Region(DimensionType, BoundingBox const&);
 
+    // Walls, or faces, of a region that is a vertical prism from minY to maxY,
+    // contains at minY standing for every layer. Scans that one layer for its
+    // rim instead of the volume.
+    void forEachPrismBlock(
+        int                                         minY,
+        int                                         maxY,
+        bool                                        faces,
+        std::function<void(BlockPos const&)> const& todo
+    ) const;
+
 public:
     static std::shared_ptr<Region>
     create(RegionType, DimensionType, BoundingBox const&, bool update = true);
@@ -55,13 +65,27 @@ public:
 
     virtual bool setOffPos(BlockPos const&) { return false; }
 
+    // Safe to call from several threads at once after getBoundingBox, which
+    // builds what a region caches: contains itself must not write any state.
     virtual bool contains(BlockPos const& pos) const { return boundingBox.contains(pos); }
 
+    // Whether every block of box is in the region. False when unsure, so callers
+    // can take a whole-box fast path only when it's safe.
+    virtual bool containsBox(BoundingBox const&) const { return false; }
+
     virtual void forEachBlockInRegion(std::function<void(BlockPos const&)>&&) const;
 
     virtual void
     forEachBlockUVInRegion(std::function<void(BlockPos const&, double, double)>&&) const;
 
+    // Visits the blocks of the region with a horizontal neighbour outside it.
+    // The default tests every block, regions that can go straight to their
+    // surface override both.
+    virtual void forEachBlockInWalls(std::function<void(BlockPos const&)>&&) const;
+
+    // Visits the blocks of the region with any neighbour outside it.
+    virtual void forEachBlockInFaces(std::function<void(BlockPos const&)>&&) const;
+
     virtual void
     forEachLine(std::function<void(BlockPos const&, BlockPos const&)>&&) const {}
 
@@ -46,5 +46,19 @@ public:
     bool contains(BlockPos const& pos) const override {
         return pos.distanceTo(center) <= radius;
     }
+
+    // a ball is convex, its corners decide
+    bool containsBox(BoundingBox const& box) const override {
+        for (int i = 0; i < 8; ++i) {
+            if (!contains(
+                    {i & 1 ? box.max.x : box.min.x,
+                     i & 2 ? box.max.y : box.min.y,
+                     i & 4 ? box.max.z : box.min.z}
+                )) {
+                return false;
+            }
+        }
+        return true;
+    }
 };
 } // namespace we
@@ -0,0 +1,95 @@
+#include "Arena.h"
+
+namespace we {
+namespace {
+// Blocks the arenas of this thread left for the next ones.
+struct SpareBlocks {
+    std::array<OperationArena::Block, OperationArena::maxBlocks> blocks{};
+    size_t                                                       count{};
+
+    ~SpareBlocks() {
+        for (size_t i = 0; i < count; ++i) {
+            delete[] blocks[i].data;
+        }
+    }
+};
+
+thread_local SpareBlocks spare;
+} // namespace
+
+void OperationArena::nextBlock(size_t minSize) {
+    if (blockCount == maxBlocks) {
+        throw std::bad_alloc{};
+    }
+    // the smallest spare block that fits
+    auto best = spare.count;
+    for (size_t i = 0; i < spare.count; ++i) {
+        if (spare.blocks[i].size >= minSize
+            && (best == spare.count || spare.blocks[i].size < spare.blocks[best].size)) {
+            best = i;
+        }
+    }
+    Block block;
+    if (best != spare.count) {
+        block              = spare.blocks[best];
+        spare.blocks[best] = spare.blocks[--spare.count];
+    } else {
+        auto size = std::max({
+            minSize,
+            minBlockSize,
+            blockCount ? blocks[blockCount - 1].size * 2 : 0,
+        });
+        block     = {new std::byte[size], size};
+        ++allocations;
+    }
+    charge((int64)block.size);
+    blocks[blockCount++] = block;
+    cursor               = block.data;
+    end                  = block.data + block.size;
+}
+
+void* OperationArena::do_allocate(size_t bytes, size_t alignment) {
+    auto bump = [&]() -> std::byte* {
+        if (!cursor) {
+            return nullptr;
+        }
+        auto p = ((uintptr_t)cursor + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        return p + bytes <= (uintptr_t)end ? (std::byte*)p : nullptr;
+    };
+    auto res = bump();
+    if (!res) {
+        nextBlock(bytes + alignment);
+        res = bump();
+    }
+    cursor  = res + bytes;
+    used   += bytes;
+    return res;
+}
+
+OperationArena::~OperationArena() {
+    for (size_t i = 0; i < blockCount; ++i) {
+        charge(-(int64)blocks[i].size);
+        if (spare.count == maxBlocks) {
+            delete[] blocks[i].data;
+        } else {
+            spare.blocks[spare.count++] = blocks[i];
+        }
+    }
+    // keep the largest blocks that fit in retainedSize
+    std::sort(
+        spare.blocks.begin(),
+        spare.blocks.begin() + spare.count,
+        [](Block const& a, Block const& b) { return a.size > b.size; }
+    );
+    size_t kept{}, retained{};
+    for (size_t i = 0; i < spare.count; ++i) {
+        if (retained + spare.blocks[i].size <= retainedSize) {
+            retained             += spare.blocks[i].size;
+            spare.blocks[kept++]  = spare.blocks[i];
+        } else {
+            delete[] spare.blocks[i].data;
+        }
+    }
+    spare.count = kept;
+}
+} // namespace we
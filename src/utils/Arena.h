@@ -0,0 +1,66 @@
+#pragma once
+
+#include "utils/TrackedAllocator.h"
+#include "worldedit/Global.h"
+
+#include <memory_resource>
+
+namespace we {
+// Bump allocation for the temporaries of one operation, all freed at once when
+// the arena goes. Its blocks go back to the thread for the next arena, so an
+// operation no bigger than the ones before it never reaches the global
+// allocator. Not thread safe: what lives on it stays on the creating thread.
+class OperationArena : public std::pmr::memory_resource {
+public:
+    struct Block {
+        std::byte* data;
+        size_t     size;
+    };
+
+    // Geometric growth from minBlockSize can't run out of these.
+    static constexpr size_t maxBlocks    = 32;
+    static constexpr size_t minBlockSize = 64 * 1024;
+
+    // Blocks a thread keeps between arenas, larger ones are given back.
+    static constexpr size_t retainedSize = 64 * 1024 * 1024;
+
+private:
+    std::array<Block, maxBlocks>   blocks{}; // the last one is being bumped
+    size_t                         blockCount{};
+    std::byte*                     cursor{};
+    std::byte*                     end{};
+    size_t                         used{};
+    size_t                         allocations{};
+    std::shared_ptr<MemoryAccount> account;
+
+    // Moves to a block of at least minSize, reusing a spare one if it can.
+    void nextBlock(size_t minSize);
+
+    void charge(int64 n) const {
+        (account ? *account : MemoryAccount::server()).charge(MemoryCategory::Scratch, n);
+    }
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+
+    void do_deallocate(void*, size_t, size_t) override {}
+
+    bool do_is_equal(std::pmr::memory_resource const& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    // Charges its blocks to the current MemoryAccount as scratch.
+    OperationArena() : account(MemoryAccount::current()) {}
+
+    OperationArena(OperationArena const&)            = delete;
+    OperationArena& operator=(OperationArena const&) = delete;
+
+    ~OperationArena() override;
+
+    // Bytes handed out so far.
+    size_t getUsed() const { return used; }
+
+    // Blocks taken from the global allocator rather than reused.
+    size_t getAllocations() const { return allocations; }
+};
+} // namespace we
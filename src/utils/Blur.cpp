@@ -0,0 +1,305 @@
+#include "Blur.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define WE_TARGET_AVX2
+#else
+#define WE_TARGET_AVX2 __attribute__((target("avx2,fma")))
+#endif
+#define WE_BLUR_AVX2 1
+#endif
+
+namespace we {
+namespace {
+// out[i] += k * in[i]
+using AxpyFn = void (*)(float* out, float const* in, float k, size_t n);
+// out[i] = sum(kernel[t] * in[i + t]), in is padded by taps - 1
+using ConvolveFn =
+    void (*)(float* out, float const* in, float const* kernel, int taps, size_t n);
+
+void axpyScalar(float* out, float const* in, float k, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        out[i] += k * in[i];
+    }
+}
+
+void convolveScalar(float* out, float const* in, float const* kernel, int taps, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        float acc = 0;
+        for (int t = 0; t < taps; ++t) {
+            acc += kernel[t] * in[i + t];
+        }
+        out[i] = acc;
+    }
+}
+
+#ifdef WE_BLUR_AVX2
+WE_TARGET_AVX2 void axpyAvx2(float* out, float const* in, float k, size_t n) {
+    __m256 vk = _mm256_set1_ps(k);
+    size_t i  = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_loadu_ps(out + i);
+        __m256 b = _mm256_loadu_ps(out + i + 8);
+        a        = _mm256_fmadd_ps(vk, _mm256_loadu_ps(in + i), a);
+        b        = _mm256_fmadd_ps(vk, _mm256_loadu_ps(in + i + 8), b);
+        _mm256_storeu_ps(out + i, a);
+        _mm256_storeu_ps(out + i + 8, b);
+    }
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(
+            out + i,
+            _mm256_fmadd_ps(vk, _mm256_loadu_ps(in + i), _mm256_loadu_ps(out + i))
+        );
+    }
+    for (; i < n; ++i) {
+        out[i] += k * in[i];
+    }
+}
+
+WE_TARGET_AVX2 void
+convolveAvx2(float* out, float const* in, float const* kernel, int taps, size_t n) {
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256 a = _mm256_setzero_ps();
+        __m256 b = _mm256_setzero_ps();
+        for (int t = 0; t < taps; ++t) {
+            __m256 vk = _mm256_set1_ps(kernel[t]);
+            a         = _mm256_fmadd_ps(vk, _mm256_loadu_ps(in + i + t), a);
+            b         = _mm256_fmadd_ps(vk, _mm256_loadu_ps(in + i + t + 8), b);
+        }
+        _mm256_storeu_ps(out + i, a);
+        _mm256_storeu_ps(out + i + 8, b);
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256 a = _mm256_setzero_ps();
+        for (int t = 0; t < taps; ++t) {
+            a = _mm256_fmadd_ps(
+                _mm256_set1_ps(kernel[t]),
+                _mm256_loadu_ps(in + i + t),
+                a
+            );
+        }
+        _mm256_storeu_ps(out + i, a);
+    }
+    convolveScalar(out + i, in + i, kernel, taps, n - i);
+}
+
+bool hasAvx2() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    bool fma     = info[2] & (1 << 12);
+    bool osxsave = info[2] & (1 << 27);
+    bool avx     = info[2] & (1 << 28);
+    if (!fma || !osxsave || !avx || (_xgetbv(0) & 6) != 6) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return info[1] & (1 << 5);
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+AxpyFn const     axpy     = hasAvx2() ? axpyAvx2 : axpyScalar;
+ConvolveFn const convolve = hasAvx2() ? convolveAvx2 : convolveScalar;
+#else
+AxpyFn const     axpy     = axpyScalar;
+ConvolveFn const convolve = convolveScalar;
+#endif
+
+double defaultSigma(int radius) { return 0.3 * (0.5 * (radius - 1) - 1) + 0.8; }
+
+// widths of n box filters whose composition approximates a gaussian
+std::array<int, 3> boxRadiiForGauss(double sigma) {
+    constexpr int n      = 3;
+    double        wIdeal = std::sqrt(12 * sigma * sigma / n + 1);
+    int           wl     = (int)std::floor(wIdeal);
+    if (wl % 2 == 0) {
+        wl--;
+    }
+    int    wu     = wl + 2;
+    double mIdeal = (12 * sigma * sigma - n * wl * wl - 4 * n * wl - 3 * n) / (-4 * wl - 4);
+    int    m      = (int)std::round(mIdeal);
+
+    std::array<int, 3> res;
+    for (int i = 0; i < n; ++i) {
+        res[i] = ((i < m ? wl : wu) - 1) / 2;
+    }
+    return res;
+}
+
+// running window sum over [i - r, i + r], zero outside, normalized by the width
+void boxRow(float* out, float const* in, int r, int n, std::vector<double>& scratch) {
+    scratch.assign(in, in + n);
+    double inv = 1.0 / (2 * r + 1);
+    double acc = 0;
+    for (int i = 0; i <= std::min(r, n - 1); ++i) {
+        acc += scratch[i];
+    }
+    out[0] = (float)(acc * inv);
+    for (int i = 1; i < n; ++i) {
+        if (i + r < n) acc += scratch[i + r];
+        if (i - r - 1 >= 0) acc -= scratch[i - r - 1];
+        out[i] = (float)(acc * inv);
+    }
+}
+
+void boxColumns(std::span<float> plane, int r, int sizex, int sizez) {
+    std::vector<double> acc(sizez, 0.0);
+    std::vector<float>  src(plane.begin(), plane.end());
+    double              inv = 1.0 / (2 * r + 1);
+
+    auto addRow = [&](int x, double sign) {
+        float const* row = src.data() + (size_t)x * sizez;
+        for (int z = 0; z < sizez; ++z) {
+            acc[z] += sign * row[z];
+        }
+    };
+    for (int x = 0; x <= std::min(r, sizex - 1); ++x) {
+        addRow(x, 1);
+    }
+    for (int x = 0; x < sizex; ++x) {
+        if (x > 0) {
+            if (x + r < sizex) addRow(x + r, 1);
+            if (x - r - 1 >= 0) addRow(x - r - 1, -1);
+        }
+        float* row = plane.data() + (size_t)x * sizez;
+        for (int z = 0; z < sizez; ++z) {
+            row[z] = (float)(acc[z] * inv);
+        }
+    }
+}
+} // namespace
+
+std::vector<float> HeightmapBlur::gaussianKernel(int radius, double sigma) {
+    static constexpr double small_gaussian_tab[][7] = {
+        {1},
+        {0.25, 0.5, 0.25},
+        {0.0625, 0.25, 0.375, 0.25, 0.0625},
+        {0.03125, 0.109375, 0.21875, 0.28125, 0.21875, 0.109375, 0.03125},
+    };
+    int                taps = radius * 2 + 1;
+    std::vector<float> res(taps);
+    if (radius < 4 && sigma < 0) {
+        for (int i = 0; i < taps; ++i) {
+            res[i] = (float)small_gaussian_tab[radius][i];
+        }
+        return res;
+    }
+    if (sigma < 0) {
+        sigma = defaultSigma(radius);
+    }
+    double scale2 = -0.5 / (sigma * sigma);
+    double sum    = 0;
+    for (int i = 0; i < taps; ++i) {
+        double x = i - radius;
+        sum     += std::exp(x * x * scale2);
+    }
+    for (int i = 0; i < taps; ++i) {
+        double x = i - radius;
+        res[i]   = (float)(std::exp(x * x * scale2) / sum);
+    }
+    return res;
+}
+
+HeightmapBlur::HeightmapBlur(int radius, double sigma, Mode mode)
+: radius(std::max(radius, 0)),
+  mode(mode) {
+    if (this->mode == Mode::Auto) {
+        this->mode = this->radius >= boxRadiusThreshold ? Mode::Box : Mode::Gaussian;
+    }
+    if (this->mode == Mode::Gaussian) {
+        kernel = gaussianKernel(this->radius, sigma);
+    } else {
+        boxRadii = boxRadiiForGauss(sigma < 0 ? defaultSigma(this->radius) : sigma);
+    }
+}
+
+void HeightmapBlur::applyGaussian(
+    std::span<float> v,
+    std::span<float> w,
+    int              sizex,
+    int              sizez
+) const {
+    int                taps = (int)kernel.size();
+    std::vector<float> padded((size_t)sizez + taps - 1, 0.0f);
+    std::vector<float> rowV(sizez), rowW(sizez);
+
+    for (int x = 0; x < sizex; ++x) {
+        for (auto [plane, row] : {std::pair{&v, &rowV}, std::pair{&w, &rowW}}) {
+            float* data = plane->data() + (size_t)x * sizez;
+            std::copy_n(data, sizez, padded.data() + radius);
+            convolve(row->data(), padded.data(), kernel.data(), taps, sizez);
+            std::copy_n(row->data(), sizez, data);
+        }
+    }
+
+    std::vector<float> srcV(v.begin(), v.end());
+    std::vector<float> srcW(w.begin(), w.end());
+    std::fill(v.begin(), v.end(), 0.0f);
+    std::fill(w.begin(), w.end(), 0.0f);
+    for (int x = 0; x < sizex; ++x) {
+        float* outV = v.data() + (size_t)x * sizez;
+        float* outW = w.data() + (size_t)x * sizez;
+        for (int t = std::max(0, x - radius); t <= std::min(sizex - 1, x + radius); ++t) {
+            float k = kernel[t - x + radius];
+            axpy(outV, srcV.data() + (size_t)t * sizez, k, sizez);
+            axpy(outW, srcW.data() + (size_t)t * sizez, k, sizez);
+        }
+    }
+}
+
+void HeightmapBlur::applyBox(std::span<float> v, std::span<float> w, int sizex, int sizez)
+    const {
+    std::vector<double> scratch;
+    for (int r : boxRadii) {
+        if (r <= 0) {
+            continue;
+        }
+        for (auto* plane : {&v, &w}) {
+            for (int x = 0; x < sizex; ++x) {
+                float* row = plane->data() + (size_t)x * sizez;
+                boxRow(row, row, r, sizez, scratch);
+            }
+            boxColumns(*plane, r, sizex, sizez);
+        }
+    }
+}
+
+void HeightmapBlur::apply(
+    std::span<float>       heights,
+    std::span<float const> weights,
+    int                    sizex,
+    int                    sizez
+) const {
+    size_t size = (size_t)sizex * sizez;
+    if (radius == 0 || size == 0 || heights.size() < size || weights.size() < size) {
+        return;
+    }
+    std::vector<float> v(size), w(weights.begin(), weights.begin() + size);
+    for (size_t i = 0; i < size; ++i) {
+        v[i] = heights[i] * w[i];
+    }
+    if (mode == Mode::Gaussian) {
+        applyGaussian(v, w, sizex, sizez);
+    } else {
+        applyBox(v, w, sizex, sizez);
+    }
+    for (size_t i = 0; i < size; ++i) {
+        if (w[i] > 1e-6f) {
+            heights[i] = v[i] / w[i];
+        }
+    }
+}
+} // namespace we
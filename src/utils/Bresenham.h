@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Math.h"
+#include "Rasterize.h"
 
 namespace we {
 class Node : public Vec3 {
@@ -0,0 +1,115 @@
+#include "Capsule.h"
+#include "Rasterize.h"
+
+#include <numbers>
+
+namespace we {
+namespace {
+struct Range {
+    double lo{std::numeric_limits<double>::infinity()};
+    double hi{-std::numeric_limits<double>::infinity()};
+
+    bool empty() const { return lo > hi; }
+
+    void unite(double l, double h) {
+        if (l <= h) {
+            lo = std::min(lo, l);
+            hi = std::max(hi, h);
+        }
+    }
+};
+} // namespace
+
+void rasterizeCapsule(SparseBlockSet& set, Vec3 const& a, Vec3 const& b, double radius) {
+    double ax = a.x, ay = a.y, az = a.z;
+    double dx = b.x - ax, dy = b.y - ay, dz = b.z - az;
+    double length2 = dx * dx + dy * dy + dz * dz;
+    double r2      = radius * radius;
+
+    // centres sit at the block coordinate + 0.5
+    int y0 = (int)std::ceil(std::min(ay, (double)b.y) - radius - 0.5);
+    int y1 = (int)std::floor(std::max(ay, (double)b.y) + radius - 0.5);
+    int z0 = (int)std::ceil(std::min(az, (double)b.z) - radius - 0.5);
+    int z1 = (int)std::floor(std::max(az, (double)b.z) + radius - 0.5);
+
+    for (int y = y0; y <= y1; ++y) {
+        for (int z = z0; z <= z1; ++z) {
+            // the row relative to a: (u, v, w), u free
+            double v = y + 0.5 - ay;
+            double w = z + 0.5 - az;
+
+            // the convex capsule meets the row in one interval, the union of
+            // its pieces' intervals
+            Range range;
+            auto  ball = [&](double cx, double dist2) {
+                if (dist2 <= r2) {
+                    double h = std::sqrt(r2 - dist2);
+                    range.unite(cx - h, cx + h);
+                }
+            };
+            ball(0, v * v + w * w);
+            ball(dx, (v - dy) * (v - dy) + (w - dz) * (w - dz));
+
+            if (length2 > 0) {
+                // projection parameter s = (u dx + c) / length2 must lie in [0, 1]
+                double c  = v * dy + w * dz;
+                double lo = -std::numeric_limits<double>::infinity();
+                double hi = std::numeric_limits<double>::infinity();
+                if (dx != 0) {
+                    double s0 = -c / dx, s1 = (length2 - c) / dx;
+                    lo        = std::min(s0, s1);
+                    hi        = std::max(s0, s1);
+                } else if (c < 0 || c > length2) {
+                    lo = hi + 1;
+                }
+                // squared distance to the axis: A u^2 + B u + C <= 0
+                double qa = 1 - dx * dx / length2;
+                double qb = -2 * dx * c / length2;
+                double qc = v * v + w * w - c * c / length2 - r2;
+                if (qa <= 1e-12) {
+                    if (qc <= 0) {
+                        range.unite(lo, hi);
+                    }
+                } else if (double disc = qb * qb - 4 * qa * qc; disc >= 0) {
+                    double root = std::sqrt(disc);
+                    range.unite(
+                        std::max(lo, (-qb - root) / (2 * qa)),
+                        std::min(hi, (-qb + root) / (2 * qa))
+                    );
+                }
+            }
+            if (range.empty()) {
+                continue;
+            }
+            int x0 = (int)std::ceil(ax + range.lo - 0.5);
+            int x1 = (int)std::floor(ax + range.hi - 0.5);
+            if (x0 <= x1) {
+                set.setSpan(y, z, x0, x1);
+            }
+        }
+    }
+}
+
+void rasterizePolyline(SparseBlockSet& set, std::span<Vec3 const> points, double radius) {
+    auto toBlock = [](Vec3 const& v) {
+        return BlockPos{(int)std::floor(v.x), (int)std::floor(v.y), (int)std::floor(v.z)};
+    };
+    for (size_t i = 0; i < points.size(); ++i) {
+        auto& from = points[i == 0 ? 0 : i - 1];
+        if (i > 0 || points.size() == 1) {
+            if (radius < 1) {
+                rasterizeLine(toBlock(from), toBlock(points[i]), set.inserter());
+            }
+            if (radius > 0) {
+                rasterizeCapsule(set, from, points[i], radius);
+            }
+        }
+    }
+}
+
+uint64 estimatePolylineBlocks(double length, double radius) {
+    double r = std::max(radius, 0.0) + 1;
+    // capped far past any memory limit, clear of overflowing the conversion
+    return (uint64)std::min(std::numbers::pi * r * r * (length + r * 4 / 3), 0x1p40);
+}
+} // namespace we
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "utils/SparseBlockSet.h"
+#include "worldedit/Global.h"
+
+namespace we {
+// Adds the blocks whose centres lie within radius of the segment a b, one exact
+// x span per row of the capsule's bounding box.
+void rasterizeCapsule(SparseBlockSet&, Vec3 const& a, Vec3 const& b, double radius);
+
+// Capsules along consecutive points; a radius below one falls back to a
+// Bresenham line, which a thin capsule can't keep connected.
+void rasterizePolyline(SparseBlockSet&, std::span<Vec3 const> points, double radius);
+
+// At most the blocks rasterizePolyline adds for a polyline of the given length:
+// a cylinder along it and the caps at its ends, the radius padded by a block.
+uint64 estimatePolylineBlocks(double length, double radius);
+} // namespace we
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+namespace we {
+// A vertical run of equal values, covering [y, y + length).
+template <class T>
+struct ColumnRun {
+    int y;
+    int length;
+    T   value;
+
+    int end() const { return y + length; }
+};
+
+template <class T>
+using ColumnRuns = std::vector<ColumnRun<T>>;
+
+// Appends value at [y, y + length), merging with the last run when equal.
+template <class T, class Alloc>
+void appendRun(
+    std::vector<ColumnRun<T>, Alloc>& runs,
+    int                               y,
+    int                               length,
+    T const&                          value
+) {
+    if (length <= 0) {
+        return;
+    }
+    if (!runs.empty() && runs.back().end() == y && runs.back().value == value) {
+        runs.back().length += length;
+    } else {
+        runs.push_back({y, length, value});
+    }
+}
+
+// Stable downward compaction of a column covering [minY, maxY]: the non-empty
+// runs keep their order and are stacked from minY, empty fills the rest.
+template <class T, class IsEmpty>
+ColumnRuns<T> compactRunsDown(
+    std::span<ColumnRun<T> const> column,
+    int                           minY,
+    int                           maxY,
+    T const&                      empty,
+    IsEmpty&&                     isEmpty
+) {
+    ColumnRuns<T> res;
+    res.reserve(column.size() + 1);
+    int y = minY;
+    for (auto& run : column) {
+        int from = std::max(run.y, minY);
+        int to   = std::min(run.end(), maxY + 1);
+        if (from >= to || isEmpty(run.value)) {
+            continue;
+        }
+        appendRun(res, y, to - from, run.value);
+        y += to - from;
+    }
+    appendRun(res, y, maxY + 1 - y, empty);
+    return res;
+}
+
+// The column with [y, y + length) set to value, y inside the column.
+template <class T>
+ColumnRuns<T>
+setRun(std::span<ColumnRun<T> const> column, int y, int length, T const& value) {
+    ColumnRuns<T> res;
+    res.reserve(column.size() + 2);
+    int  end = y + length;
+    bool set = false;
+    for (auto& run : column) {
+        if (run.end() <= y || run.y >= end) {
+            if (!set && run.y >= end) {
+                appendRun(res, y, length, value);
+                set = true;
+            }
+            appendRun(res, run.y, run.length, run.value);
+            continue;
+        }
+        appendRun(res, run.y, y - run.y, run.value);
+        if (!set) {
+            appendRun(res, y, length, value);
+            set = true;
+        }
+        appendRun(res, end, run.end() - end, run.value);
+    }
+    if (!set) {
+        appendRun(res, y, length, value);
+    }
+    return res;
+}
+
+// Calls todo(y, value) for every y whose value differs between two run lists
+// covering the same range, in O(runs) plus the number of changed blocks.
+template <class T, class Fn>
+void forEachChangedBlock(
+    std::span<ColumnRun<T> const> before,
+    std::span<ColumnRun<T> const> after,
+    Fn&&                          todo
+) {
+    size_t i = 0;
+    size_t j = 0;
+    while (i < before.size() && j < after.size()) {
+        auto& a    = before[i];
+        auto& b    = after[j];
+        int   from = std::max(a.y, b.y);
+        int   to   = std::min(a.end(), b.end());
+        if (from < to && !(a.value == b.value)) {
+            for (int y = from; y < to; ++y) {
+                todo(y, b.value);
+            }
+        }
+        if (a.end() <= b.end()) ++i;
+        if (b.end() <= a.end()) ++j;
+    }
+}
+} // namespace we
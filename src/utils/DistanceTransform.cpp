@@ -0,0 +1,152 @@
+#include "DistanceTransform.h"
+
+#include <algorithm>
+#include <execution>
+#include <numeric>
+
+namespace we {
+static int64_t floorDiv(int64_t a, int64_t b) {
+    return a / b - (a % b != 0 && (a < 0) != (b < 0));
+}
+
+// f(x, i) is the distance from x to the feature nearest to i, where g is the
+// distance of i to it along the previous axes. sep(i, u) is the last x at which
+// i is at least as close as u, for i < u.
+struct Manhattan {
+    static int64_t f(int64_t x, int64_t i, int64_t g) { return std::abs(x - i) + g; }
+
+    static int64_t sep(int64_t i, int64_t u, int64_t gi, int64_t gu) {
+        if (gu >= gi + u - i) {
+            return distanceInf;
+        }
+        if (gi > gu + u - i) {
+            return -distanceInf;
+        }
+        return floorDiv(gu - gi + u + i, 2);
+    }
+};
+
+struct Chebyshev {
+    static int64_t f(int64_t x, int64_t i, int64_t g) {
+        return std::max(std::abs(x - i), g);
+    }
+
+    static int64_t sep(int64_t i, int64_t u, int64_t gi, int64_t gu) {
+        if (gi <= gu) {
+            return std::max(i + gu, floorDiv(i + u, 2));
+        }
+        return std::min(u - gi, floorDiv(i + u, 2));
+    }
+};
+
+struct Euclidean {
+    static int64_t f(int64_t x, int64_t i, int64_t g) { return (x - i) * (x - i) + g; }
+
+    static int64_t sep(int64_t i, int64_t u, int64_t gi, int64_t gu) {
+        return floorDiv(u * u - i * i + gu - gi, 2 * (u - i));
+    }
+};
+
+// Lower envelope pass over one line of n cells spaced stride apart.
+template <class M>
+static void envelopePass(
+    int*              line,
+    int               n,
+    size_t            stride,
+    std::vector<int>& s,
+    std::vector<int>& t,
+    std::vector<int>& g
+) {
+    s.resize(n);
+    t.resize(n);
+    g.resize(n);
+    for (int u = 0; u < n; ++u) {
+        g[u] = line[u * stride];
+    }
+    int q = 0;
+    s[0]  = 0;
+    t[0]  = 0;
+    for (int u = 1; u < n; ++u) {
+        while (q >= 0 && M::f(t[q], s[q], g[s[q]]) > M::f(t[q], u, g[u])) {
+            q--;
+        }
+        if (q < 0) {
+            q    = 0;
+            s[0] = u;
+        } else if (auto w = 1 + M::sep(s[q], u, g[s[q]], g[u]); w < n) {
+            q++;
+            s[q] = u;
+            t[q] = (int)w;
+        }
+    }
+    for (int u = n - 1; u >= 0; --u) {
+        line[u * stride] = (int)std::min<int64_t>(M::f(u, s[q], g[s[q]]), distanceInf);
+        if (u == t[q]) {
+            q--;
+        }
+    }
+}
+
+template <class M>
+static void transform(std::span<int> dist, int sizex, int sizey, int sizez) {
+    auto runLines = [&](size_t count, int n, size_t stride, auto&& lineStart) {
+        std::vector<size_t> lines(count);
+        std::iota(lines.begin(), lines.end(), size_t{});
+        std::for_each(std::execution::par, lines.begin(), lines.end(), [&](size_t l) {
+            thread_local std::vector<int> s, t, g;
+            envelopePass<M>(dist.data() + lineStart(l), n, stride, s, t, g);
+        });
+    };
+    // z lines, one per (y, x)
+    runLines((size_t)sizey * sizex, sizez, sizex, [&](size_t l) {
+        return (l / sizex) * sizez * sizex + l % sizex;
+    });
+    // y lines, one per (z, x)
+    runLines((size_t)sizez * sizex, sizey, (size_t)sizez * sizex, [&](size_t l) {
+        return l;
+    });
+}
+
+std::vector<int> distanceTransform(
+    std::span<uint8_t const> features,
+    int                      sizex,
+    int                      sizey,
+    int                      sizez,
+    DistanceMetric           metric
+) {
+    std::vector<int> dist(features.size());
+
+    // x lines: plain 1D distance by a forward and a backward sweep
+    size_t rows = (size_t)sizey * sizez;
+    for (size_t r = 0; r < rows; ++r) {
+        auto* f = features.data() + r * sizex;
+        auto* d = dist.data() + r * sizex;
+        int   last{distanceInf};
+        for (int x = 0; x < sizex; ++x) {
+            last = f[x] ? 0 : std::min(last + 1, distanceInf);
+            d[x] = last;
+        }
+        last = distanceInf;
+        for (int x = sizex - 1; x >= 0; --x) {
+            last = f[x] ? 0 : std::min(last + 1, distanceInf);
+            d[x] = std::min(d[x], last);
+            if (metric == DistanceMetric::Euclidean && d[x] != distanceInf) {
+                d[x] *= d[x];
+            }
+        }
+    }
+
+    switch (metric) {
+    case DistanceMetric::Manhattan:
+        transform<Manhattan>(dist, sizex, sizey, sizez);
+        break;
+    case DistanceMetric::Chebyshev:
+        transform<Chebyshev>(dist, sizex, sizey, sizez);
+        break;
+    case DistanceMetric::Euclidean:
+        transform<Euclidean>(dist, sizex, sizey, sizez);
+        break;
+    }
+    return dist;
+}
+} // namespace we
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace we {
+enum class DistanceMetric {
+    Manhattan,
+    Chebyshev,
+    Euclidean,
+};
+
+// Distance stored for cells that can't reach any feature.
+inline constexpr int distanceInf = std::numeric_limits<int>::max() / 4;
+
+// Exact distance from every cell of a [sizey][sizez][sizex] grid to its nearest
+// feature cell, as three separable passes of linear time each (Meijster et al.).
+// Euclidean distances are returned squared.
+std::vector<int> distanceTransform(
+    std::span<uint8_t const> features,
+    int                      sizex,
+    int                      sizey,
+    int                      sizez,
+    DistanceMetric           metric
+);
+
+// The largest stored distance that still lies within thickness.
+inline int distanceLimit(DistanceMetric metric, int thickness) {
+    return metric == DistanceMetric::Euclidean ? thickness * thickness : thickness;
+}
+} // namespace we
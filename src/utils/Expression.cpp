@@ -0,0 +1,343 @@
+#include "Expression.h"
+#include "Trace.h"
+
+#include <array>
+#include <charconv>
+#include <cctype>
+
+namespace we {
+namespace {
+using Op = Expression::Op;
+
+struct Function {
+    std::string_view name;
+    int              arity;
+    Op               op;
+};
+
+constexpr std::array functions{
+    Function{"abs",   1, Op::Abs  },
+    Function{"sqrt",  1, Op::Sqrt },
+    Function{"exp",   1, Op::Exp  },
+    Function{"log",   1, Op::Log  },
+    Function{"floor", 1, Op::Floor},
+    Function{"ceil",  1, Op::Ceil },
+    Function{"round", 1, Op::Round},
+    Function{"sin",   1, Op::Sin  },
+    Function{"cos",   1, Op::Cos  },
+    Function{"tan",   1, Op::Tan  },
+    Function{"min",   2, Op::Min  },
+    Function{"max",   2, Op::Max  },
+    Function{"pow",   2, Op::Pow  },
+};
+
+int arity(Op op) {
+    switch (op) {
+    case Op::Const:
+    case Op::Var:
+        return 0;
+    case Op::Neg:
+    case Op::Not:
+        return 1;
+    default:
+        for (auto& f : functions) {
+            if (f.op == op) return f.arity;
+        }
+        return 2;
+    }
+}
+
+// Recursive descent, lowest precedence first:
+// || , && , comparisons , + - , * / % , unary - + ! , ^ (right associative)
+class Parser {
+    std::string_view                    src;
+    std::span<std::string_view const>   vars;
+    size_t                              pos{};
+    int                                 depth{};
+    int                                 nesting{}; // of parseUnary, every cycle passes it
+    std::vector<Expression::Instruction> code;
+
+    // Deeper input fails instead of overflowing the stack of the descent.
+    static constexpr int maxNesting = 256;
+
+public:
+    std::string error;
+
+    Parser(std::string_view src, std::span<std::string_view const> vars)
+    : src(src),
+      vars(vars) {}
+
+    std::vector<Expression::Instruction> parse() {
+        parseOr();
+        skipSpace();
+        if (error.empty() && pos < src.size()) {
+            fail(std::string{"unexpected '"} + src[pos] + "'");
+        }
+        return std::move(code);
+    }
+
+private:
+    void fail(std::string message) {
+        if (error.empty()) {
+            error = std::move(message) + " at " + std::to_string(pos);
+        }
+    }
+
+    void skipSpace() {
+        while (pos < src.size() && std::isspace((unsigned char)src[pos])) ++pos;
+    }
+
+    bool accept(std::string_view token) {
+        skipSpace();
+        if (src.substr(pos).starts_with(token)) {
+            pos += token.size();
+            return true;
+        }
+        return false;
+    }
+
+    void emit(Op op, double value = 0, int var = 0) {
+        if (op == Op::Const || op == Op::Var) {
+            if (++depth > (int)Expression::maxStackSize) {
+                fail("expression too deep");
+            }
+        } else {
+            depth -= arity(op) - 1;
+        }
+        code.push_back({op, var, value});
+    }
+
+    void parseOr() {
+        parseAnd();
+        while (accept("||")) {
+            parseAnd();
+            emit(Op::Or);
+        }
+    }
+
+    void parseAnd() {
+        parseComparison();
+        while (accept("&&")) {
+            parseComparison();
+            emit(Op::And);
+        }
+    }
+
+    void parseComparison() {
+        parseSum();
+        while (true) {
+            Op op;
+            if (accept("<=")) op = Op::LessEqual;
+            else if (accept(">=")) op = Op::GreaterEqual;
+            else if (accept("==")) op = Op::Equal;
+            else if (accept("!=")) op = Op::NotEqual;
+            else if (accept("<")) op = Op::Less;
+            else if (accept(">")) op = Op::Greater;
+            else return;
+            parseSum();
+            emit(op);
+        }
+    }
+
+    void parseSum() {
+        parseProduct();
+        while (true) {
+            Op op;
+            if (accept("+")) op = Op::Add;
+            else if (accept("-")) op = Op::Sub;
+            else return;
+            parseProduct();
+            emit(op);
+        }
+    }
+
+    void parseProduct() {
+        parseUnary();
+        while (true) {
+            Op op;
+            if (accept("*")) op = Op::Mul;
+            else if (accept("/")) op = Op::Div;
+            else if (accept("%")) op = Op::Mod;
+            else return;
+            parseUnary();
+            emit(op);
+        }
+    }
+
+    void parseUnary() {
+        if (nesting >= maxNesting) {
+            fail("nested deeper than " + std::to_string(maxNesting));
+            return;
+        }
+        ++nesting;
+        skipSpace();
+        if (accept("-")) {
+            parseUnary();
+            emit(Op::Neg);
+        } else if (accept("+")) {
+            parseUnary();
+        } else if (!src.substr(pos).starts_with("!=") && accept("!")) {
+            parseUnary();
+            emit(Op::Not);
+        } else {
+            parsePower();
+        }
+        --nesting;
+    }
+
+    void parsePower() {
+        parsePrimary();
+        if (accept("^")) {
+            parseUnary();
+            emit(Op::Pow);
+        }
+    }
+
+    void parsePrimary() {
+        skipSpace();
+        if (!error.empty()) {
+            return;
+        }
+        if (pos >= src.size()) {
+            fail("unexpected end");
+            return;
+        }
+        if (accept("(")) {
+            parseOr();
+            if (!accept(")")) fail("expected ')'");
+            return;
+        }
+        char c = src[pos];
+        if (std::isdigit((unsigned char)c) || c == '.') {
+            double value{};
+            auto [end, ec] = std::from_chars(src.data() + pos, src.data() + src.size(), value);
+            if (ec != std::errc{}) {
+                fail("invalid number");
+                return;
+            }
+            pos = end - src.data();
+            emit(Op::Const, value);
+            return;
+        }
+        if (!std::isalpha((unsigned char)c) && c != '_') {
+            fail(std::string{"unexpected '"} + c + "'");
+            return;
+        }
+        size_t begin = pos;
+        while (pos < src.size() && (std::isalnum((unsigned char)src[pos]) || src[pos] == '_'))
+            ++pos;
+        auto name = src.substr(begin, pos - begin);
+        if (accept("(")) {
+            auto f = std::ranges::find(functions, name, &Function::name);
+            if (f == functions.end()) {
+                fail("unknown function '" + std::string{name} + "'");
+                return;
+            }
+            for (int i = 0; i < f->arity; ++i) {
+                if (i > 0 && !accept(",")) {
+                    fail("'" + std::string{name} + "' takes " + std::to_string(f->arity) + " arguments");
+                    return;
+                }
+                parseOr();
+            }
+            if (!accept(")")) fail("expected ')'");
+            emit(f->op);
+            return;
+        }
+        if (auto v = std::ranges::find(vars, name); v != vars.end()) {
+            emit(Op::Var, 0, (int)(v - vars.begin()));
+        } else if (name == "pi") {
+            emit(Op::Const, std::numbers::pi);
+        } else if (name == "e") {
+            emit(Op::Const, std::numbers::e);
+        } else {
+            fail("unknown variable '" + std::string{name} + "'");
+        }
+    }
+};
+} // namespace
+
+template <class T>
+T Expression::run(std::span<T const> vars) const {
+    using std::abs, std::ceil, std::cos, std::exp, std::floor, std::fmod, std::log,
+        std::max, std::min, std::pow, std::round, std::sin, std::sqrt, std::tan;
+    std::array<T, maxStackSize> stack;
+    size_t                      top{};
+    for (auto& ins : code) {
+        if (ins.op == Op::Const) {
+            stack[top++] = T(ins.value);
+            continue;
+        }
+        if (ins.op == Op::Var) {
+            stack[top++] = vars[ins.var];
+            continue;
+        }
+        T& a = stack[top - arity(ins.op)];
+        T& b = stack[top - 1];
+        switch (ins.op) {
+        case Op::Neg: a = -a; break;
+        case Op::Not: a = logicalNot(a); break;
+        case Op::Add: a = a + b; break;
+        case Op::Sub: a = a - b; break;
+        case Op::Mul: a = a * b; break;
+        case Op::Div: a = a / b; break;
+        case Op::Mod: a = fmod(a, b); break;
+        case Op::Pow: a = pow(a, b); break;
+        case Op::Less: a = less(a, b); break;
+        case Op::LessEqual: a = lessEqual(a, b); break;
+        case Op::Greater: a = less(b, a); break;
+        case Op::GreaterEqual: a = lessEqual(b, a); break;
+        case Op::Equal: a = equal(a, b); break;
+        case Op::NotEqual: a = logicalNot(equal(a, b)); break;
+        case Op::And: a = logicalAnd(a, b); break;
+        case Op::Or: a = logicalOr(a, b); break;
+        case Op::Abs: a = abs(a); break;
+        case Op::Sqrt: a = sqrt(a); break;
+        case Op::Exp: a = exp(a); break;
+        case Op::Log: a = log(a); break;
+        case Op::Floor: a = floor(a); break;
+        case Op::Ceil: a = ceil(a); break;
+        case Op::Round: a = round(a); break;
+        case Op::Sin: a = sin(a); break;
+        case Op::Cos: a = cos(a); break;
+        case Op::Tan: a = tan(a); break;
+        case Op::Min: a = min(a, b); break;
+        case Op::Max: a = max(a, b); break;
+        default: break;
+        }
+        top -= arity(ins.op) - 1;
+    }
+    return stack[0];
+}
+
+std::expected<Expression, std::string>
+Expression::compile(std::string_view source, std::span<std::string_view const> vars) {
+    trace::Span span{"Expression::compile"};
+    Parser parser{source, vars};
+    auto   code = parser.parse();
+    if (!parser.error.empty()) {
+        return std::unexpected(std::move(parser.error));
+    }
+    // fold operators whose operands are all constants
+    Expression res;
+    for (auto& ins : code) {
+        res.code.push_back(ins);
+        auto n = arity(ins.op);
+        if (n == 0 || !std::all_of(res.code.end() - 1 - n, res.code.end() - 1, [](auto& i) {
+                return i.op == Op::Const;
+            })) {
+            continue;
+        }
+        Expression constant;
+        constant.code.assign(res.code.end() - 1 - n, res.code.end());
+        auto value = constant.eval(std::span<double const>{});
+        res.code.resize(res.code.size() - 1 - n);
+        res.code.push_back({Op::Const, 0, value});
+    }
+    return res;
+}
+
+double Expression::eval(std::span<double const> vars) const { return run(vars); }
+
+Interval Expression::eval(std::span<Interval const> vars) const { return run(vars); }
+} // namespace we
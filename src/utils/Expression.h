@@ -0,0 +1,77 @@
+#pragma once
+
+#include "utils/Interval.h"
+
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace we {
+// Arithmetic expression compiled once to stack code, evaluable over doubles or
+// over intervals. Supports + - * / % ^, comparisons, && || !, parentheses,
+// pi, e and the functions abs sqrt exp log floor ceil round sin cos tan min max pow.
+// Truth values are 1 and 0; any value > 0.5 counts as true.
+class Expression {
+public:
+    enum class Op : uint8_t {
+        Const,
+        Var,
+        Neg,
+        Not,
+        Add,
+        Sub,
+        Mul,
+        Div,
+        Mod,
+        Pow,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Equal,
+        NotEqual,
+        And,
+        Or,
+        Abs,
+        Sqrt,
+        Exp,
+        Log,
+        Floor,
+        Ceil,
+        Round,
+        Sin,
+        Cos,
+        Tan,
+        Min,
+        Max,
+    };
+
+    struct Instruction {
+        Op     op;
+        int    var{};
+        double value{};
+    };
+
+    static constexpr size_t maxStackSize = 64;
+
+private:
+    std::vector<Instruction> code;
+
+    template <class T>
+    T run(std::span<T const> vars) const;
+
+public:
+    // variables are referred to by their index in vars when evaluating.
+    static std::expected<Expression, std::string>
+    compile(std::string_view source, std::span<std::string_view const> vars);
+
+    std::span<Instruction const> getCode() const { return code; }
+
+    double eval(std::span<double const> vars) const;
+
+    Interval eval(std::span<Interval const> vars) const;
+};
+} // namespace we
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+namespace we {
+enum class Connectivity {
+    Six,
+    TwentySix,
+};
+
+// Span based scanline flood fill limited to a box.
+// The visited and rejected sets are dense bitsets over the box and the seed stack
+// keeps its capacity between fills, so one FloodFill reused by a brush doesn't
+// allocate once it has grown to the brush size.
+class FloodFill {
+    // A span of filled cells whose neighbour rows are still to be scanned,
+    // grown along x first.
+    struct Seed {
+        int x0, x1, y, z;
+    };
+
+    BoundingBox                box;
+    BlockPos                   size;
+    std::vector<uint64>        visited;  // filled
+    std::vector<uint64>        rejected; // canFill tested false
+    std::vector<Seed>          seeds;
+    std::optional<BoundingBox> filled;
+    size_t                     count{};
+
+    size_t index(int x, int y, int z) const {
+        return ((size_t)(y - box.min.y) * size.z + (z - box.min.z)) * size.x
+             + (x - box.min.x);
+    }
+    static bool isSet(std::vector<uint64> const& bits, size_t i) {
+        return (bits[i >> 6] >> (i & 63)) & 1;
+    }
+    static void set(std::vector<uint64>& bits, size_t i) {
+        bits[i >> 6] |= 1ull << (i & 63);
+    }
+
+    // Fills the cell if canFill holds for it, which is tested once per cell.
+    template <class Pred, class Fn>
+    bool tryFill(int x, int y, int z, Pred& canFill, Fn& todo) {
+        auto i = index(x, y, z);
+        if (isSet(visited, i) || isSet(rejected, i)) {
+            return false;
+        }
+        BlockPos pos{x, y, z};
+        if (!canFill(pos)) {
+            set(rejected, i);
+            return false;
+        }
+        set(visited, i);
+        todo(pos);
+        count++;
+        filled = filled ? filled->merge(pos) : BoundingBox{pos};
+        return true;
+    }
+
+    // fills the cells of row (y, z) within [x0, x1] that canFill holds for,
+    // pushing one seed per run of them
+    template <class Pred, class Fn>
+    void scanRow(int x0, int x1, int y, int z, Pred& canFill, Fn& todo) {
+        if (y < box.min.y || y > box.max.y || z < box.min.z || z > box.max.z) {
+            return;
+        }
+        x0 = std::max(x0, box.min.x);
+        x1 = std::min(x1, box.max.x);
+        std::optional<int> start;
+        for (int x = x0; x <= x1; ++x) {
+            if (tryFill(x, y, z, canFill, todo)) {
+                start = start.value_or(x);
+                continue;
+            }
+            if (start) {
+                seeds.push_back({*start, x - 1, y, z});
+                start.reset();
+            }
+        }
+        if (start) {
+            seeds.push_back({*start, x1, y, z});
+        }
+    }
+
+public:
+    FloodFill() = default;
+
+    explicit FloodFill(BoundingBox const& box) { reset(box); }
+
+    // Clears the visited and rejected sets, keeping the allocation when the box
+    // isn't larger.
+    void reset(BoundingBox const& newBox) {
+        box       = newBox;
+        size      = box.max - box.min + 1;
+        auto bits = (size_t)size.x * size.y * size.z;
+        visited.assign((bits + 63) / 64, 0);
+        rejected.assign(visited.size(), 0);
+        seeds.clear();
+        filled.reset();
+    }
+
+    void reset(BlockPos const& center, int radius) {
+        reset(BoundingBox{center - radius, center + radius});
+    }
+
+    BoundingBox const& getBox() const { return box; }
+
+    // Bounding box of the blocks filled by the last call of fill, none if it
+    // filled nothing.
+    std::optional<BoundingBox> const& getFilledBox() const { return filled; }
+
+    bool contains(BlockPos const& pos) const {
+        return box.contains(pos) && isSet(visited, index(pos.x, pos.y, pos.z));
+    }
+
+    // Fills from seed, calling todo for every block for which canFill holds.
+    // Cells canFill rejected stay rejected until reset, so fills in between
+    // must agree on it. Returns the count of filled blocks.
+    template <class Pred, class Fn>
+    size_t
+    fill(BlockPos const& seed, Connectivity connectivity, Pred&& canFill, Fn&& todo) {
+        filled.reset();
+        count = 0;
+        seeds.clear();
+        if (!box.contains(seed) || !tryFill(seed.x, seed.y, seed.z, canFill, todo)) {
+            return 0;
+        }
+        seeds.push_back({seed.x, seed.x, seed.y, seed.z});
+        while (!seeds.empty()) {
+            auto [x0, x1, y, z] = seeds.back();
+            seeds.pop_back();
+            while (x0 > box.min.x && tryFill(x0 - 1, y, z, canFill, todo)) --x0;
+            while (x1 < box.max.x && tryFill(x1 + 1, y, z, canFill, todo)) ++x1;
+
+            if (connectivity == Connectivity::Six) {
+                scanRow(x0, x1, y - 1, z, canFill, todo);
+                scanRow(x0, x1, y + 1, z, canFill, todo);
+                scanRow(x0, x1, y, z - 1, canFill, todo);
+                scanRow(x0, x1, y, z + 1, canFill, todo);
+            } else {
+                for (int dy = -1; dy <= 1; ++dy) {
+                    for (int dz = -1; dz <= 1; ++dz) {
+                        if (dy != 0 || dz != 0) {
+                            scanRow(x0 - 1, x1 + 1, y + dy, z + dz, canFill, todo);
+                        }
+                    }
+                }
+            }
+        }
+        return count;
+    }
+};
+} // namespace we
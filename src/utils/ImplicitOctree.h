@@ -0,0 +1,97 @@
+#pragma once
+
+#include "utils/Interval.h"
+#include "worldedit/Global.h"
+
+namespace we {
+// Finds the blocks of a box where an implicit predicate holds, refining only the
+// octree cells the bound can't decide. Cells start as the sub chunks the box
+// covers; a cell bounded wholly true is emitted as is, wholly false is skipped.
+//
+// bound(BoundingBox) bounds the predicate over every block of the box;
+// test(BlockPos) decides one block; todo(BlockPos) receives the result.
+// With hollow only blocks with a 6-neighbour outside the shape are emitted.
+template <class Bound, class Test, class Fn>
+void forEachImplicitBlock(
+    BoundingBox const& box,
+    bool               hollow,
+    Bound&&            bound,
+    Test&&             test,
+    Fn&&               todo
+) {
+    auto visit = [&](auto&& self, BoundingBox const& cell) -> void {
+        auto value = bound(cell);
+        if (value.isFalse()) {
+            return;
+        }
+        if (value.isTrue()) {
+            if (!hollow) {
+                for (int y = cell.min.y; y <= cell.max.y; ++y)
+                    for (int z = cell.min.z; z <= cell.max.z; ++z)
+                        for (int x = cell.min.x; x <= cell.max.x; ++x) todo(BlockPos{x, y, z});
+                return;
+            }
+            // the neighbours are all inside too, nothing here is on the shell
+            if (bound(BoundingBox{cell.min - 1, cell.max + 1}).isTrue()) {
+                return;
+            }
+        }
+        if (cell.min == cell.max) {
+            auto& pos = cell.min;
+            if (!test(pos)) {
+                return;
+            }
+            if (hollow) {
+                static constexpr std::array<BlockPos, 6> neighbours{
+                    BlockPos{1,  0,  0 },
+                    BlockPos{-1, 0,  0 },
+                    BlockPos{0,  1,  0 },
+                    BlockPos{0,  -1, 0 },
+                    BlockPos{0,  0,  1 },
+                    BlockPos{0,  0,  -1},
+                };
+                if (std::ranges::all_of(neighbours, [&](BlockPos const& offset) {
+                        return test(pos + offset);
+                    })) {
+                    return;
+                }
+            }
+            todo(pos);
+            return;
+        }
+        // split every axis longer than one block in two
+        auto mid = BlockPos{
+            (cell.min.x + cell.max.x) >> 1,
+            (cell.min.y + cell.max.y) >> 1,
+            (cell.min.z + cell.max.z) >> 1,
+        };
+        std::array<BlockPos, 2> mins{cell.min, mid + 1};
+        std::array<BlockPos, 2> maxs{mid, cell.max};
+        for (int i = 0; i < 8; ++i) {
+            BoundingBox child{
+                {mins[i & 1].x, mins[i >> 1 & 1].y, mins[i >> 2].z},
+                {maxs[i & 1].x, maxs[i >> 1 & 1].y, maxs[i >> 2].z}
+            };
+            if (child.min.x <= child.max.x && child.min.y <= child.max.y
+                && child.min.z <= child.max.z) {
+                self(self, child);
+            }
+        }
+    };
+    for (int cx = box.min.x >> 4; cx <= box.max.x >> 4; ++cx) {
+        for (int cz = box.min.z >> 4; cz <= box.max.z >> 4; ++cz) {
+            for (int cy = box.min.y >> 4; cy <= box.max.y >> 4; ++cy) {
+                BlockPos    origin{cx << 4, cy << 4, cz << 4};
+                BoundingBox cell{origin, origin + 15};
+                cell.min.x = std::max(cell.min.x, box.min.x);
+                cell.min.y = std::max(cell.min.y, box.min.y);
+                cell.min.z = std::max(cell.min.z, box.min.z);
+                cell.max.x = std::min(cell.max.x, box.max.x);
+                cell.max.y = std::min(cell.max.y, box.max.y);
+                cell.max.z = std::min(cell.max.z, box.max.z);
+                visit(visit, cell);
+            }
+        }
+    }
+}
+} // namespace we
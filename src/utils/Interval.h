@@ -0,0 +1,281 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numbers>
+
+namespace we {
+// Closed interval [lo, hi] of doubles; every operation returns a superset of the
+// values its operands can produce, so an undecided result is never wrong. Where
+// the scalar result may be NaN the interval is undefined(), which every
+// arithmetic operation passes on and no comparison decides.
+struct Interval {
+    double lo;
+    double hi;
+    bool   nan{}; // may be NaN, then also whole
+
+    constexpr Interval(double v = 0) : lo(v), hi(v) {}
+    constexpr Interval(double lo, double hi) : lo(lo), hi(hi) {}
+
+    static constexpr Interval whole() {
+        return {-std::numeric_limits<double>::infinity(),
+                std::numeric_limits<double>::infinity()};
+    }
+
+    // May be NaN: the scalar evaluation left its domain somewhere.
+    static constexpr Interval undefined() {
+        auto res = whole();
+        res.nan  = true;
+        return res;
+    }
+
+    bool isPoint() const { return !nan && lo == hi; }
+
+    bool contains(double v) const { return lo <= v && v <= hi; }
+
+    // Truth follows the scalar convention: value > 0.5. NaN is neither.
+    bool isTrue() const { return !nan && lo > 0.5; }
+
+    bool isFalse() const { return hi <= 0.5; }
+};
+
+namespace interval_detail {
+inline constexpr double inf = std::numeric_limits<double>::infinity();
+
+// Rounds outward by one ulp to absorb the rounding of the scalar evaluation.
+inline Interval outward(double lo, double hi) {
+    if (std::isnan(lo) || std::isnan(hi)) {
+        return Interval::undefined();
+    }
+    return {std::nextafter(lo, -inf), std::nextafter(hi, inf)};
+}
+
+inline Interval boolean(bool canBeFalse, bool canBeTrue) {
+    return {canBeFalse ? 0.0 : 1.0, canBeTrue ? 1.0 : 0.0};
+}
+} // namespace interval_detail
+
+inline Interval operator+(Interval a, Interval b) {
+    if (a.nan || b.nan) return Interval::undefined();
+    return interval_detail::outward(a.lo + b.lo, a.hi + b.hi);
+}
+
+inline Interval operator-(Interval a, Interval b) {
+    if (a.nan || b.nan) return Interval::undefined();
+    return interval_detail::outward(a.lo - b.hi, a.hi - b.lo);
+}
+
+inline Interval operator-(Interval a) {
+    if (a.nan) return a;
+    return {-a.hi, -a.lo};
+}
+
+inline Interval operator*(Interval a, Interval b) {
+    if (a.nan || b.nan) return Interval::undefined();
+    double p[4]{a.lo * b.lo, a.lo * b.hi, a.hi * b.lo, a.hi * b.hi};
+    // 0 * inf, the scalar result may be NaN too
+    if (std::ranges::any_of(p, [](double v) { return std::isnan(v); })) {
+        return Interval::undefined();
+    }
+    auto [lo, hi] = std::minmax({p[0], p[1], p[2], p[3]});
+    return interval_detail::outward(lo, hi);
+}
+
+inline Interval operator/(Interval a, Interval b) {
+    // 0 / 0 is NaN
+    if (a.nan || b.nan || b.contains(0)) {
+        return Interval::undefined();
+    }
+    return a * interval_detail::outward(1 / b.hi, 1 / b.lo);
+}
+
+inline Interval fmod(Interval a, Interval b) {
+    // fmod(x, 0) and fmod(inf, y) are NaN
+    if (a.nan || b.nan || b.contains(0) || !std::isfinite(a.lo) || !std::isfinite(a.hi)) {
+        return Interval::undefined();
+    }
+    if (b.isPoint()) {
+        double m = std::abs(b.lo);
+        // fmod is increasing on [km, (k + 1)m) for x >= 0 and on (-(k + 1)m, -km]
+        bool samePeriod = a.lo >= 0 ? std::floor(a.lo / m) == std::floor(a.hi / m)
+                        : a.hi <= 0 ? std::ceil(a.lo / m) == std::ceil(a.hi / m)
+                                    : false;
+        if (samePeriod) {
+            return interval_detail::outward(std::fmod(a.lo, m), std::fmod(a.hi, m));
+        }
+    }
+    double m = std::max(std::abs(b.lo), std::abs(b.hi));
+    return {a.lo < 0 ? -m : 0, a.hi > 0 ? m : 0};
+}
+
+inline Interval abs(Interval a) {
+    if (a.nan || a.lo >= 0) return a;
+    if (a.hi <= 0) return -a;
+    return {0, std::max(-a.lo, a.hi)};
+}
+
+inline Interval min(Interval a, Interval b) {
+    if (a.nan || b.nan) return Interval::undefined();
+    return {std::min(a.lo, b.lo), std::min(a.hi, b.hi)};
+}
+
+inline Interval max(Interval a, Interval b) {
+    if (a.nan || b.nan) return Interval::undefined();
+    return {std::max(a.lo, b.lo), std::max(a.hi, b.hi)};
+}
+
+inline Interval floor(Interval a) {
+    if (a.nan) return a;
+    return {std::floor(a.lo), std::floor(a.hi)};
+}
+
+inline Interval ceil(Interval a) {
+    if (a.nan) return a;
+    return {std::ceil(a.lo), std::ceil(a.hi)};
+}
+
+inline Interval round(Interval a) {
+    if (a.nan) return a;
+    return {std::round(a.lo), std::round(a.hi)};
+}
+
+inline Interval sqrt(Interval a) {
+    // NaN below 0, even if only part of the interval is
+    if (a.nan || a.lo < 0) return Interval::undefined();
+    return interval_detail::outward(std::sqrt(a.lo), std::sqrt(a.hi));
+}
+
+inline Interval exp(Interval a) {
+    if (a.nan) return a;
+    return interval_detail::outward(std::exp(a.lo), std::exp(a.hi));
+}
+
+inline Interval log(Interval a) {
+    // NaN below 0; log(0) is -inf, which the arithmetic after may turn to NaN
+    if (a.nan || a.lo <= 0) return Interval::undefined();
+    return interval_detail::outward(std::log(a.lo), std::log(a.hi));
+}
+
+inline Interval pow(Interval a, Interval b) {
+    if (a.nan || b.nan) return Interval::undefined();
+    if (b.isPoint() && b.lo == std::trunc(b.lo) && std::abs(b.lo) < 1024) {
+        int n = (int)b.lo;
+        if (n < 0) {
+            return Interval{1} / pow(a, Interval(-n));
+        }
+        if (n % 2 == 1 || a.lo >= 0) {
+            return interval_detail::outward(std::pow(a.lo, n), std::pow(a.hi, n));
+        }
+        auto m = abs(a);
+        return interval_detail::outward(std::pow(m.lo, n), std::pow(m.hi, n));
+    }
+    // a negative base to a fractional power is NaN
+    if (a.lo > 0) {
+        return exp(b * log(a));
+    }
+    return Interval::undefined();
+}
+
+namespace interval_detail {
+// Bounds a 2pi periodic function f, which peaks at maxPhase and bottoms out at
+// minPhase, and is monotonic between them.
+template <class F>
+Interval periodic(Interval a, F f, double maxPhase, double minPhase) {
+    constexpr double pi = std::numbers::pi;
+    // of inf too, NaN
+    if (a.nan || !std::isfinite(a.lo) || !std::isfinite(a.hi)) {
+        return Interval::undefined();
+    }
+    if (!(a.hi - a.lo < 2 * pi)) {
+        return {-1, 1};
+    }
+    // whether lo <= phase + 2k pi <= hi for some integer k
+    auto hits = [&](double phase) {
+        return std::ceil((a.lo - phase) / (2 * pi)) <= std::floor((a.hi - phase) / (2 * pi));
+    };
+    double l   = f(a.lo);
+    double h   = f(a.hi);
+    auto   res = outward(std::min(l, h), std::max(l, h));
+    if (hits(maxPhase)) res.hi = 1;
+    if (hits(minPhase)) res.lo = -1;
+    return res;
+}
+} // namespace interval_detail
+
+inline Interval sin(Interval a) {
+    return interval_detail::periodic(
+        a,
+        [](double v) { return std::sin(v); },
+        std::numbers::pi / 2,
+        -std::numbers::pi / 2
+    );
+}
+
+inline Interval cos(Interval a) {
+    return interval_detail::periodic(
+        a,
+        [](double v) { return std::cos(v); },
+        0,
+        std::numbers::pi
+    );
+}
+
+inline Interval tan(Interval a) {
+    constexpr double pi = std::numbers::pi;
+    if (a.nan || !std::isfinite(a.lo) || !std::isfinite(a.hi)) {
+        return Interval::undefined();
+    }
+    if (!(a.hi - a.lo < pi)
+        || std::ceil((a.lo - pi / 2) / pi) <= std::floor((a.hi - pi / 2) / pi)) {
+        return Interval::whole();
+    }
+    return interval_detail::outward(std::tan(a.lo), std::tan(a.hi));
+}
+
+inline Interval less(Interval a, Interval b) {
+    return interval_detail::boolean(!(a.hi < b.lo), a.lo < b.hi);
+}
+
+inline Interval lessEqual(Interval a, Interval b) {
+    return interval_detail::boolean(!(a.hi <= b.lo), a.lo <= b.hi);
+}
+
+inline Interval equal(Interval a, Interval b) {
+    return interval_detail::boolean(
+        !(a.isPoint() && b.isPoint() && a.lo == b.lo),
+        a.lo <= b.hi && b.lo <= a.hi
+    );
+}
+
+inline Interval logicalNot(Interval a) {
+    return interval_detail::boolean(!a.isFalse(), !a.isTrue());
+}
+
+inline Interval logicalAnd(Interval a, Interval b) {
+    return interval_detail::boolean(
+        !(a.isTrue() && b.isTrue()),
+        !a.isFalse() && !b.isFalse()
+    );
+}
+
+inline Interval logicalOr(Interval a, Interval b) {
+    return interval_detail::boolean(
+        !a.isTrue() && !b.isTrue(),
+        !(a.isFalse() && b.isFalse())
+    );
+}
+
+// Scalar counterparts, so one evaluator serves both.
+inline double less(double a, double b) { return a < b; }
+
+inline double lessEqual(double a, double b) { return a <= b; }
+
+inline double equal(double a, double b) { return a == b; }
+
+inline double logicalNot(double a) { return !(a > 0.5); }
+
+inline double logicalAnd(double a, double b) { return a > 0.5 && b > 0.5; }
+
+inline double logicalOr(double a, double b) { return a > 0.5 || b > 0.5; }
+} // namespace we
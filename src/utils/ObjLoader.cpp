@@ -0,0 +1,73 @@
+#include "ObjLoader.h"
+
+#include <tiny_obj_loader.h>
+
+namespace we {
+std::expected<Mesh, std::string> loadObj(std::filesystem::path const& path) {
+    tinyobj::ObjReaderConfig config;
+    config.triangulate     = true;
+    config.vertex_color    = true;
+    config.mtl_search_path = path.parent_path().string();
+
+    tinyobj::ObjReader reader;
+    if (!reader.ParseFromFile(path.string(), config)) {
+        return std::unexpected(
+            reader.Error().empty() ? std::string{"can't read the file"} : reader.Error()
+        );
+    }
+    auto& attrib    = reader.GetAttrib();
+    auto& materials = reader.GetMaterials();
+
+    Mesh mesh;
+    mesh.positions.reserve(attrib.vertices.size() / 3);
+    for (size_t i = 0; i + 2 < attrib.vertices.size(); i += 3) {
+        mesh.positions.emplace_back(
+            (float)attrib.vertices[i],
+            (float)attrib.vertices[i + 1],
+            (float)attrib.vertices[i + 2]
+        );
+    }
+    // tinyobjloader fills missing vertex colours with white
+    if (attrib.colors.size() == attrib.vertices.size()
+        && std::ranges::any_of(attrib.colors, [](auto c) { return c != 1; })) {
+        mesh.colors.reserve(mesh.positions.size());
+        for (size_t i = 0; i + 2 < attrib.colors.size(); i += 3) {
+            mesh.colors.push_back({
+                (float)attrib.colors[i],
+                (float)attrib.colors[i + 1],
+                (float)attrib.colors[i + 2]
+            });
+        }
+    }
+    for (auto& shape : reader.GetShapes()) {
+        auto& indices = shape.mesh.indices;
+        for (size_t face = 0; face * 3 + 2 < indices.size(); ++face) {
+            std::array<uint32_t, 3> triangle;
+            bool                    valid = true;
+            for (int k = 0; k < 3; ++k) {
+                auto index  = indices[face * 3 + k].vertex_index;
+                valid      &= index >= 0 && (size_t)index < mesh.positions.size();
+                triangle[k] = (uint32_t)index;
+            }
+            if (!valid) {
+                continue;
+            }
+            mesh.triangles.push_back(triangle);
+            if (materials.empty()) {
+                continue;
+            }
+            Mesh::Color color{1, 1, 1};
+            if (face < shape.mesh.material_ids.size()) {
+                auto id = shape.mesh.material_ids[face];
+                if (id >= 0 && (size_t)id < materials.size()) {
+                    auto& kd = materials[id].diffuse;
+                    color    = {(float)kd[0], (float)kd[1], (float)kd[2]};
+                }
+            }
+            mesh.triangleColors.resize(mesh.triangles.size() - 1, {1, 1, 1});
+            mesh.triangleColors.push_back(color);
+        }
+    }
+    return mesh;
+}
+} // namespace we
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "utils/Voxelizer.h"
+
+#include <expected>
+#include <filesystem>
+
+namespace we {
+// Loads the triangles of an OBJ model in its own units, with its vertex colours
+// and the diffuse colour of its materials when present.
+std::expected<Mesh, std::string> loadObj(std::filesystem::path const&);
+} // namespace we
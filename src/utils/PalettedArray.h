@@ -0,0 +1,60 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+#include <bit>
+
+namespace we {
+// N values of which only a few differ, stored as a palette and indices packed
+// at the fewest bits the palette needs, as sub chunk storage does: one value
+// repeated takes no indices at all, two take a bit each.
+template <class T, size_t N>
+class PalettedArray {
+    std::vector<T>      palette;
+    std::vector<uint64> words;
+    uchar               bits{};
+
+    size_t getPerWord() const { return 64 / bits; }
+
+public:
+    PalettedArray() = default;
+
+    explicit PalettedArray(T const& value) : palette{value} {}
+
+    explicit PalettedArray(std::span<T const, N> values) {
+        std::array<ushort, N> indices;
+        for (size_t i = 0; i < N; ++i) {
+            // palettes are short, a scan beats a map
+            auto iter  = std::ranges::find(palette, values[i]);
+            indices[i] = (ushort)(iter - palette.begin());
+            if (iter == palette.end()) {
+                palette.push_back(values[i]);
+            }
+        }
+        bits = (uchar)std::bit_width(palette.size() - 1);
+        if (bits == 0) {
+            return;
+        }
+        auto perWord = getPerWord();
+        words.resize((N + perWord - 1) / perWord);
+        for (size_t i = 0; i < N; ++i) {
+            words[i / perWord] |= (uint64)indices[i] << (i % perWord * bits);
+        }
+    }
+
+    T const& operator[](size_t i) const {
+        if (bits == 0) {
+            return palette[0];
+        }
+        auto perWord = getPerWord();
+        auto index   = (words[i / perWord] >> (i % perWord * bits)) & ((1ull << bits) - 1);
+        return palette[index];
+    }
+
+    std::span<T const> getPalette() const { return palette; }
+
+    size_t getMemory() const {
+        return palette.capacity() * sizeof(T) + words.capacity() * sizeof(uint64);
+    }
+};
+} // namespace we
@@ -0,0 +1,158 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+#include <iterator>
+
+namespace we {
+// Integer voxel rasterizers after Zingl's "A Rasterizing Algorithm for Drawing
+// Curves". Blocks go straight to an output iterator, so there is no indirect call
+// per block; the std::vector overloads append to a caller owned buffer.
+
+// Count of blocks rasterizeLine writes from a to b, both ends included.
+inline size_t lineLength(BlockPos const& a, BlockPos const& b) {
+    return (size_t)std::max({std::abs(b.x - a.x), std::abs(b.y - a.y), std::abs(b.z - a.z)})
+         + 1;
+}
+
+// 26-connected line from a to b, stepping the dominant axis every block and the
+// others when their error wraps. With withStart false a itself is skipped, to
+// chain segments without repeating the joints.
+template <std::output_iterator<BlockPos> Out>
+Out rasterizeLine(BlockPos const& a, BlockPos const& b, Out out, bool withStart = true) {
+    int dx = std::abs(b.x - a.x), sx = a.x < b.x ? 1 : -1;
+    int dy = std::abs(b.y - a.y), sy = a.y < b.y ? 1 : -1;
+    int dz = std::abs(b.z - a.z), sz = a.z < b.z ? 1 : -1;
+    int dm = std::max({dx, dy, dz});
+    int ex = dm / 2, ey = dm / 2, ez = dm / 2;
+
+    // all ones when the error wrapped, selecting the step without a branch
+    auto step = [dm](int& error, int delta, int& coord, int sign) {
+        error    -= delta;
+        int mask  = error >> 31;
+        error    += dm & mask;
+        coord    += sign & mask;
+    };
+    BlockPos pos = a;
+    if (withStart) {
+        *out++ = pos;
+    }
+    for (int i = 0; i < dm; ++i) {
+        step(ex, dx, pos.x, sx);
+        step(ey, dy, pos.y, sy);
+        step(ez, dz, pos.z, sz);
+        *out++ = pos;
+    }
+    return out;
+}
+
+inline void rasterizeLine(BlockPos const& a, BlockPos const& b, std::vector<BlockPos>& out) {
+    auto size = out.size();
+    out.resize(size + lineLength(a, b));
+    rasterizeLine(a, b, out.begin() + size);
+}
+
+// Bezier curve of N control points, 3 for quadratic and 4 for cubic. It is split
+// in de Casteljau halves until the control points lie within half a block of
+// the chord, and the chords are then drawn as lines.
+template <size_t N, std::output_iterator<BlockPos> Out>
+Out rasterizeBezier(std::array<Vec3, N> const& control, Out out) {
+    static_assert(N >= 2);
+    using Point = std::array<double, 3>;
+    auto toBlock = [](Point const& p) {
+        return BlockPos{(int)std::floor(p[0]), (int)std::floor(p[1]), (int)std::floor(p[2])};
+    };
+    std::array<Point, N> points;
+    for (size_t i = 0; i < N; ++i) {
+        points[i] = {control[i].x, control[i].y, control[i].z};
+    }
+    BlockPos last      = toBlock(points[0]);
+    bool     started   = false;
+    auto     subdivide = [&](auto&& self, std::array<Point, N> const& p, int depth) -> void {
+        double deviation{};
+        for (size_t i = 1; i + 1 < N; ++i) {
+            double t = (double)i / (N - 1), d2{};
+            for (int k = 0; k < 3; ++k) {
+                double d  = p[i][k] - (p[0][k] + (p[N - 1][k] - p[0][k]) * t);
+                d2       += d * d;
+            }
+            deviation = std::max(deviation, d2);
+        }
+        if (deviation <= 0.25 || depth >= 16) {
+            auto end = toBlock(p[N - 1]);
+            out      = rasterizeLine(last, end, out, !started);
+            last     = end;
+            started  = true;
+            return;
+        }
+        // de Casteljau at 1/2; the left half is the first of every row, the right
+        // half the last, read backwards
+        std::array<Point, N> left, right, row = p;
+        for (size_t n = N; n > 0; --n) {
+            left[N - n]  = row[0];
+            right[n - 1] = row[n - 1];
+            for (size_t i = 0; i + 1 < n; ++i) {
+                for (int k = 0; k < 3; ++k) row[i][k] = (row[i][k] + row[i + 1][k]) / 2;
+            }
+        }
+        self(self, left, depth + 1);
+        self(self, right, depth + 1);
+    };
+    subdivide(subdivide, points, 0);
+    return out;
+}
+
+template <size_t N>
+void rasterizeBezier(std::array<Vec3, N> const& control, std::vector<BlockPos>& out) {
+    rasterizeBezier(control, std::back_inserter(out));
+}
+
+// Axis aligned ellipse with semi axes a and b, in the plane through center normal
+// to axis (0 x, 1 y, 2 z); a runs along the first remaining axis. The four
+// quadrants are walked together, so a block where two meet may repeat.
+template <std::output_iterator<BlockPos> Out>
+Out rasterizeEllipse(BlockPos const& center, int a, int b, int axis, Out out) {
+    auto place = [&](int u, int v) {
+        BlockPos pos = center;
+        switch (axis) {
+        case 0:
+            pos.y += u;
+            pos.z += v;
+            break;
+        case 1:
+            pos.x += u;
+            pos.z += v;
+            break;
+        default:
+            pos.x += u;
+            pos.y += v;
+            break;
+        }
+        return pos;
+    };
+    int64 x = -a, y = 0;
+    int64 a2 = (int64)a * a, b2 = (int64)b * b;
+    int64 err = x * (2 * b2 + x) + b2;
+    do {
+        *out++   = place((int)-x, (int)y);
+        *out++   = place((int)x, (int)y);
+        *out++   = place((int)x, (int)-y);
+        *out++   = place((int)-x, (int)-y);
+        int64 e2 = 2 * err;
+        if (e2 >= (x * 2 + 1) * b2) err += (++x * 2 + 1) * b2;
+        if (e2 <= (y * 2 + 1) * a2) err += (++y * 2 + 1) * a2;
+    } while (x <= 0);
+    // flat ellipses stop early, finish the tips
+    while (y++ < b) {
+        *out++ = place(0, (int)y);
+        *out++ = place(0, (int)-y);
+    }
+    return out;
+}
+
+inline void
+rasterizeEllipse(BlockPos const& center, int a, int b, int axis, std::vector<BlockPos>& out) {
+    out.reserve(out.size() + 4 * (size_t)(a + b + 1));
+    rasterizeEllipse(center, a, b, axis, std::back_inserter(out));
+}
+} // namespace we
@@ -0,0 +1,187 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+namespace we {
+// Inclusive run [x0, x1] of one row.
+struct Span {
+    int x0;
+    int x1;
+
+    bool empty() const { return x0 > x1; }
+
+    int size() const { return empty() ? 0 : x1 - x0 + 1; }
+};
+
+// The spans of one row; a shell row is at most two of them.
+class RowSpans {
+    std::array<Span, 2> spans{};
+    int                 count{};
+
+public:
+    void add(Span span) {
+        if (!span.empty()) {
+            spans[count++] = span;
+        }
+    }
+
+    // outer minus inner, inner must lie within outer or be empty.
+    static RowSpans difference(Span outer, Span inner) {
+        RowSpans res;
+        if (inner.empty()) {
+            res.add(outer);
+        } else {
+            res.add({outer.x0, inner.x0 - 1});
+            res.add({inner.x1 + 1, outer.x1});
+        }
+        return res;
+    }
+
+    Span const* begin() const { return spans.data(); }
+
+    Span const* end() const { return spans.data() + count; }
+
+    bool empty() const { return count == 0; }
+
+    size_t size() const {
+        size_t res{};
+        for (auto& span : *this) {
+            res += span.size();
+        }
+        return res;
+    }
+};
+
+// Largest x >= 0 with x * x <= n, -1 if n < 0.
+inline int isqrt(int64 n) {
+    if (n < 0) {
+        return -1;
+    }
+    auto x = (int64)std::sqrt((double)n);
+    while (x * x > n) --x;
+    while ((x + 1) * (x + 1) <= n) ++x;
+    return (int)x;
+}
+
+// Half width of the row at squared distance dist2 from the centre of a ball
+// of radius + 0.5, -1 if the row misses the ball.
+// x * x <= r * r + r + 0.25 - dist2 is exact in integers, the 0.25 never counts.
+inline int ballHalfWidth(int radius, int64 dist2) {
+    return isqrt((int64)radius * radius + radius - dist2);
+}
+
+// A block shape stored as x spans per (y, z) row of its bounding box.
+// Memory is O(rows) rather than O(volume), and rows are disjoint by
+// construction, so nothing needs deduplicating before it is written.
+class SpanShape {
+    BoundingBox           box;
+    int                   sizez;
+    std::vector<RowSpans> rows;
+
+public:
+    explicit SpanShape(BoundingBox const& box)
+    : box(box),
+      sizez(box.max.z - box.min.z + 1),
+      rows((size_t)(box.max.y - box.min.y + 1) * sizez) {}
+
+    BoundingBox const& getBoundingBox() const { return box; }
+
+    RowSpans& at(int y, int z) {
+        return rows[(size_t)(y - box.min.y) * sizez + (z - box.min.z)];
+    }
+
+    RowSpans const& at(int y, int z) const {
+        return rows[(size_t)(y - box.min.y) * sizez + (z - box.min.z)];
+    }
+
+    size_t volume() const {
+        size_t res{};
+        for (auto& row : rows) {
+            res += row.size();
+        }
+        return res;
+    }
+
+    template <class Fn>
+    void forEachBlock(Fn&& todo) const {
+        for (int y = box.min.y; y <= box.max.y; ++y) {
+            for (int z = box.min.z; z <= box.max.z; ++z) {
+                for (auto& span : at(y, z)) {
+                    for (int x = span.x0; x <= span.x1; ++x) {
+                        todo(BlockPos{x, y, z});
+                    }
+                }
+            }
+        }
+    }
+
+    // Filled ball of radius + 0.5. The hollow shell keeps the blocks with an
+    // outward neighbour outside the ball, so it has no gaps.
+    static SpanShape sphere(BlockPos const& center, int radius, bool hollow) {
+        SpanShape res({center - radius, center + radius});
+        for (int y = -radius; y <= radius; ++y) {
+            int64 ay = std::abs(y);
+            for (int z = -radius; z <= radius; ++z) {
+                int64 az = std::abs(z);
+                int   a  = ballHalfWidth(radius, ay * ay + az * az);
+                if (a < 0) {
+                    continue;
+                }
+                // b = -1 leaves the inner span empty, so the row stays filled
+                int b = hollow ? std::min({
+                                     a - 1,
+                                     ballHalfWidth(radius, (ay + 1) * (ay + 1) + az * az),
+                                     ballHalfWidth(radius, ay * ay + (az + 1) * (az + 1)),
+                                 })
+                               : -1;
+                res.at(center.y + y, center.z + z) = RowSpans::difference(
+                    {center.x - a, center.x + a},
+                    {center.x - b, center.x + b}
+                );
+            }
+        }
+        return res;
+    }
+
+    // Vertical cylinder with its base at center, extending height blocks up.
+    // The hollow one is the side wall only.
+    static SpanShape
+    cylinder(BlockPos const& center, int radius, int height, bool hollow) {
+        SpanShape res({
+            {center.x - radius, center.y,              center.z - radius},
+            {center.x + radius, center.y + height - 1, center.z + radius}
+        });
+        for (int z = -radius; z <= radius; ++z) {
+            int64 az  = std::abs(z);
+            int   a   = ballHalfWidth(radius, az * az);
+            int   b   = hollow ? std::min(a - 1, ballHalfWidth(radius, (az + 1) * (az + 1)))
+                               : -1;
+            auto  row = RowSpans::difference(
+                {center.x - a, center.x + a},
+                {center.x - b, center.x + b}
+            );
+            for (int y = center.y; y < center.y + height; ++y) {
+                res.at(y, center.z + z) = row;
+            }
+        }
+        return res;
+    }
+
+    // Cube of side 2 * size + 1; the hollow one is its six faces.
+    static SpanShape cube(BlockPos const& center, int size, bool hollow) {
+        SpanShape res({center - size, center + size});
+        auto&     box = res.box;
+        for (int y = box.min.y; y <= box.max.y; ++y) {
+            for (int z = box.min.z; z <= box.max.z; ++z) {
+                bool face = y == box.min.y || y == box.max.y || z == box.min.z
+                         || z == box.max.z;
+                res.at(y, z) = RowSpans::difference(
+                    {box.min.x, box.max.x},
+                    hollow && !face ? Span{box.min.x + 1, box.max.x - 1} : Span{1, 0}
+                );
+            }
+        }
+        return res;
+    }
+};
+} // namespace we
@@ -0,0 +1,165 @@
+#pragma once
+
+#include "utils/TrackedAllocator.h"
+#include "worldedit/Global.h"
+
+#include <bit>
+
+namespace we {
+// A set of blocks stored as 16x16x16 tiles of 16 bit x rows, allocated on first
+// touch, so memory follows the covered volume rather than its bounding box.
+class SparseBlockSet {
+public:
+    // Row (y & 15) << 4 | (z & 15), bit x & 15.
+    using Tile = std::array<uint16_t, 256>;
+
+private:
+    TrackedHashMap<uint64, Tile, MemoryCategory::Scratch> tiles;
+
+    static uint64 key(int tx, int ty, int tz) {
+        return ((uint64)(tx & 0x1FFFFF) << 42) | ((uint64)(tz & 0x1FFFFF) << 21)
+             | (uint64)(ty & 0x1FFFFF);
+    }
+
+    static int unpack(uint64 v) { return (int)((int64)(v << 43) >> 43); }
+
+    uint16_t row(int tx, int ty, int tz, int y, int z) const {
+        auto iter = tiles.find(key(tx, ty, tz));
+        return iter == tiles.end() ? 0 : iter->second[(y & 15) << 4 | (z & 15)];
+    }
+
+public:
+    // Output iterator adding every block assigned through it.
+    class Inserter {
+        SparseBlockSet* set;
+
+    public:
+        using difference_type = ptrdiff_t;
+
+        explicit Inserter(SparseBlockSet& set) : set(&set) {}
+
+        Inserter& operator=(BlockPos const& pos) {
+            set->set(pos);
+            return *this;
+        }
+        Inserter& operator*() { return *this; }
+        Inserter& operator++() { return *this; }
+        Inserter  operator++(int) { return *this; }
+    };
+
+    Inserter inserter() { return Inserter{*this}; }
+
+    bool empty() const { return tiles.empty(); }
+
+    size_t tileCount() const { return tiles.size(); }
+
+    void clear() { tiles.clear(); }
+
+    // The box of the sub chunks holding blocks, call only when not empty.
+    BoundingBox getTileBox() const {
+        std::optional<BoundingBox> res;
+        for (auto& [k, tile] : tiles) {
+            BlockPos    min{unpack(k >> 42) << 4, unpack(k) << 4, unpack(k >> 21) << 4};
+            BoundingBox box{min, min + 15};
+            res = res ? res->merge(box) : box;
+        }
+        return *res;
+    }
+
+    void set(BlockPos const& pos) {
+        auto& tile = tiles[key(pos.x >> 4, pos.y >> 4, pos.z >> 4)];
+        tile[(pos.y & 15) << 4 | (pos.z & 15)] |= (uint16_t)(1u << (pos.x & 15));
+    }
+
+    // Adds the blocks x0..x1 of the row at (y, z).
+    void setSpan(int y, int z, int x0, int x1) {
+        for (int tx = x0 >> 4; tx <= x1 >> 4; ++tx) {
+            int from = std::max(x0, tx << 4) & 15;
+            int to   = std::min(x1, (tx << 4) + 15) & 15;
+            tiles[key(tx, y >> 4, z >> 4)][(y & 15) << 4 | (z & 15)] |=
+                (uint16_t)(((2u << to) - 1) & ~((1u << from) - 1));
+        }
+    }
+
+    void merge(SparseBlockSet const& other) {
+        for (auto& [k, tile] : other.tiles) {
+            auto& into = tiles[k];
+            for (int i = 0; i < 256; ++i) into[i] |= tile[i];
+        }
+    }
+
+    bool contains(BlockPos const& pos) const {
+        return row(pos.x >> 4, pos.y >> 4, pos.z >> 4, pos.y, pos.z) >> (pos.x & 15) & 1;
+    }
+
+    size_t size() const {
+        size_t res{};
+        for (auto& [k, tile] : tiles) {
+            for (auto r : tile) {
+                res += std::popcount(r);
+            }
+        }
+        return res;
+    }
+
+    // The blocks with at least one of their 6 neighbours outside the set,
+    // computed a whole row at a time.
+    SparseBlockSet shell() const {
+        SparseBlockSet res;
+        for (auto& [k, tile] : tiles) {
+            int   tx = unpack(k >> 42), tz = unpack(k >> 21), ty = unpack(k);
+            Tile* out{};
+            for (int i = 0; i < 256; ++i) {
+                uint32_t r = tile[i];
+                if (!r) {
+                    continue;
+                }
+                int y = (ty << 4) | (i >> 4);
+                int z = (tz << 4) | (i & 15);
+
+                uint32_t left  = (r << 1 | row(tx - 1, ty, tz, y, z) >> 15) & 0xFFFF;
+                uint32_t right = r >> 1 | (row(tx + 1, ty, tz, y, z) & 1u) << 15;
+                uint32_t inner = r & left & right;
+                if (inner) {
+                    auto neighbour = [&](int ny, int nz) {
+                        return (uint32_t)row(tx, ny >> 4, nz >> 4, ny, nz);
+                    };
+                    inner &= neighbour(y + 1, z) & neighbour(y - 1, z) & neighbour(y, z + 1)
+                           & neighbour(y, z - 1);
+                }
+                if (r & ~inner) {
+                    if (!out) out = &res.tiles[k];
+                    (*out)[i] = (uint16_t)(r & ~inner);
+                }
+            }
+        }
+        return res;
+    }
+
+    // Visits the blocks ordered by sub chunk, like EditBuffer::flush writes.
+    template <class Fn>
+    void forEachBlock(Fn&& todo) const {
+        std::vector<uint64> keys;
+        keys.reserve(tiles.size());
+        for (auto& [k, tile] : tiles) {
+            keys.push_back(k);
+        }
+        std::ranges::sort(keys, {}, [](uint64 k) {
+            return std::tuple{unpack(k >> 42), unpack(k >> 21), unpack(k)};
+        });
+        for (auto k : keys) {
+            auto& tile = tiles.find(k)->second;
+            int   tx = unpack(k >> 42), tz = unpack(k >> 21), ty = unpack(k);
+            for (int i = 0; i < 256; ++i) {
+                for (uint32_t r = tile[i]; r; r &= r - 1) {
+                    todo(BlockPos{
+                        (tx << 4) | std::countr_zero(r),
+                        (ty << 4) | (i >> 4),
+                        (tz << 4) | (i & 15)
+                    });
+                }
+            }
+        }
+    }
+};
+} // namespace we
@@ -0,0 +1,110 @@
+#include "Trace.h"
+
+#include <fstream>
+#include <mutex>
+
+namespace we {
+namespace trace {
+namespace {
+// Written by its own thread only. The sequence is odd while the slot is being
+// written, so a dump running alongside skips the slots it would see torn.
+struct Slot {
+    std::atomic<uint64>      seq{};
+    std::atomic<char const*> name{};
+    std::atomic<int64>       begin{};
+    std::atomic<int64>       end{};
+};
+
+struct Ring {
+    uint64                         tid;
+    std::atomic<uint64>            head{}; // spans ever written
+    std::array<Slot, ringCapacity> slots;
+
+    explicit Ring(uint64 tid) : tid(tid) {}
+};
+
+std::mutex                         ringsMutex;
+std::vector<std::shared_ptr<Ring>> rings;
+
+// Spans that began earlier belong to a previous trace.
+std::atomic<int64> origin{};
+
+int64 ticks(Clock::time_point t) {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch())
+        .count();
+}
+
+Ring& threadRing() {
+    // the registry keeps the ring, so spans of exited threads are dumped too
+    thread_local std::shared_ptr<Ring> ring = [] {
+        std::lock_guard lock{ringsMutex};
+        return rings.emplace_back(std::make_shared<Ring>(rings.size() + 1));
+    }();
+    return *ring;
+}
+} // namespace
+
+void start() {
+    origin.store(ticks(Clock::now()), std::memory_order_relaxed);
+    enabled.store(true, std::memory_order_release);
+}
+
+void stop() { enabled.store(false, std::memory_order_release); }
+
+void record(char const* name, Clock::time_point begin, Clock::time_point end) {
+    auto& ring  = threadRing();
+    auto  index = ring.head.load(std::memory_order_relaxed);
+    auto& slot  = ring.slots[index % ringCapacity];
+    auto  seq   = slot.seq.load(std::memory_order_relaxed);
+    slot.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.name.store(name, std::memory_order_relaxed);
+    slot.begin.store(ticks(begin), std::memory_order_relaxed);
+    slot.end.store(ticks(end), std::memory_order_relaxed);
+    slot.seq.store(seq + 2, std::memory_order_release);
+    ring.head.store(index + 1, std::memory_order_release);
+}
+
+std::optional<size_t> dump(std::filesystem::path const& path) {
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+    std::ofstream file{path};
+    if (!file) {
+        return std::nullopt;
+    }
+    std::vector<std::shared_ptr<Ring>> snapshot;
+    {
+        std::lock_guard lock{ringsMutex};
+        snapshot = rings;
+    }
+    auto from = origin.load(std::memory_order_relaxed);
+    file.setf(std::ios::fixed);
+    file.precision(3);
+    file << R"({"displayTimeUnit":"ms","traceEvents":[)";
+    size_t count{};
+    for (auto& ring : snapshot) {
+        auto head = ring->head.load(std::memory_order_acquire);
+        for (auto i = head - std::min<uint64>(head, ringCapacity); i < head; ++i) {
+            auto& slot = ring->slots[i % ringCapacity];
+            auto  seq  = slot.seq.load(std::memory_order_acquire);
+            auto  name = slot.name.load(std::memory_order_relaxed);
+            auto  b    = slot.begin.load(std::memory_order_relaxed);
+            auto  e    = slot.end.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq % 2 || slot.seq.load(std::memory_order_relaxed) != seq || b < from) {
+                continue;
+            }
+            // names are literals, nothing to escape
+            file << (count++ ? ",\n" : "\n") << R"({"name":")" << name
+                 << R"(","cat":"worldedit","ph":"X","pid":1,"tid":)" << ring->tid
+                 << R"(,"ts":)" << (b - from) / 1e3 << R"(,"dur":)" << (e - b) / 1e3 << "}";
+        }
+    }
+    file << "\n]}\n";
+    if (!file) {
+        return std::nullopt;
+    }
+    return count;
+}
+} // namespace trace
+} // namespace we
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+
+namespace we {
+namespace trace {
+// Opt-in tracing of the edit pipeline. Spans go into a ring buffer of the
+// thread that ran them and are dumped as a Chrome trace, for chrome://tracing
+// or ui.perfetto.dev. While tracing is off a span costs one relaxed load.
+inline std::atomic_bool enabled{};
+
+// Spans each thread keeps, the oldest are overwritten first.
+inline constexpr size_t ringCapacity = 1 << 15;
+
+using Clock = std::chrono::steady_clock;
+
+// Forgets the spans recorded so far and starts recording.
+void start();
+
+void stop();
+
+// Writes the spans recorded since start, returning how many, or nullopt if the
+// file can't be written.
+std::optional<size_t> dump(std::filesystem::path const&);
+
+void record(char const* name, Clock::time_point begin, Clock::time_point end);
+
+// Records the time until it goes out of scope. The name must outlive the trace,
+// a literal in practice.
+class Span {
+    char const*       name{};
+    Clock::time_point begin;
+
+public:
+    explicit Span(char const* name) {
+        if (enabled.load(std::memory_order_relaxed)) {
+            this->name = name;
+            begin      = Clock::now();
+        }
+    }
+
+    Span(Span const&)            = delete;
+    Span& operator=(Span const&) = delete;
+
+    ~Span() {
+        if (name) {
+            record(name, begin, Clock::now());
+        }
+    }
+};
+} // namespace trace
+} // namespace we
@@ -0,0 +1,33 @@
+#include "TrackedAllocator.h"
+
+namespace we {
+thread_local std::shared_ptr<MemoryAccount> MemoryAccount::currentAccount;
+
+std::string_view getMemoryCategoryName(MemoryCategory category) {
+    switch (category) {
+    case MemoryCategory::History:
+        return "history";
+    case MemoryCategory::EditBuffer:
+        return "edit buffer";
+    case MemoryCategory::RegionCache:
+        return "region cache";
+    case MemoryCategory::Scratch:
+        return "scratch";
+    default:
+        std::unreachable();
+    }
+}
+
+MemoryAccount& MemoryAccount::server() {
+    static MemoryAccount account;
+    return account;
+}
+
+int64 MemoryAccount::total() const {
+    int64 res{};
+    for (auto& n : bytes) {
+        res += n.load(std::memory_order_relaxed);
+    }
+    return res;
+}
+} // namespace we
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+#include <atomic>
+
+namespace we {
+enum class MemoryCategory : uchar {
+    History,     // undo records
+    EditBuffer,  // pending writes of an operation
+    RegionCache, // blocks cached by selections
+    Scratch,     // bitmaps and sets built while an operation runs
+};
+
+inline constexpr size_t memoryCategoryCount = 4;
+
+std::string_view getMemoryCategoryName(MemoryCategory);
+
+// Bytes held by the edit data structures of one player, or of the whole server,
+// per category. Every charge to a player is charged to the server too.
+class MemoryAccount {
+    std::array<std::atomic<int64>, memoryCategoryCount> bytes{};
+
+    static thread_local std::shared_ptr<MemoryAccount> currentAccount;
+
+public:
+    // Makes account the one containers created on this thread charge, until it
+    // goes out of scope. A null account charges the server alone.
+    class Scope {
+        std::shared_ptr<MemoryAccount> previous;
+
+    public:
+        explicit Scope(std::shared_ptr<MemoryAccount> account)
+        : previous(std::exchange(currentAccount, std::move(account))) {}
+
+        Scope(Scope const&)            = delete;
+        Scope& operator=(Scope const&) = delete;
+
+        ~Scope() { currentAccount = std::move(previous); }
+    };
+
+    static MemoryAccount& server();
+
+    static std::shared_ptr<MemoryAccount> const& current() { return currentAccount; }
+
+    int64 get(MemoryCategory category) const {
+        return bytes[(size_t)category].load(std::memory_order_relaxed);
+    }
+
+    int64 total() const;
+
+    void charge(MemoryCategory category, int64 n) {
+        bytes[(size_t)category].fetch_add(n, std::memory_order_relaxed);
+        if (auto& s = server(); this != &s) {
+            s.bytes[(size_t)category].fetch_add(n, std::memory_order_relaxed);
+        }
+    }
+};
+
+// std::allocator charging what it holds to the account current when the
+// container was created, for as long as the memory is held.
+template <class T, MemoryCategory Category>
+class TrackedAllocator {
+    template <class, MemoryCategory>
+    friend class TrackedAllocator;
+
+    std::shared_ptr<MemoryAccount> account;
+
+    void charge(int64 n) const {
+        (account ? *account : MemoryAccount::server()).charge(Category, n);
+    }
+
+public:
+    using value_type                             = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    template <class U>
+    struct rebind {
+        using other = TrackedAllocator<U, Category>;
+    };
+
+    TrackedAllocator() noexcept : account(MemoryAccount::current()) {}
+
+    template <class U>
+    TrackedAllocator(TrackedAllocator<U, Category> const& other) noexcept
+    : account(other.account) {}
+
+    T* allocate(size_t n) {
+        auto res = std::allocator<T>{}.allocate(n);
+        charge((int64)(n * sizeof(T)));
+        return res;
+    }
+
+    void deallocate(T* p, size_t n) noexcept {
+        charge(-(int64)(n * sizeof(T)));
+        std::allocator<T>{}.deallocate(p, n);
+    }
+
+    template <class U>
+    bool operator==(TrackedAllocator<U, Category> const& other) const noexcept {
+        return account == other.account;
+    }
+};
+
+template <class T, MemoryCategory Category>
+using TrackedVector = std::vector<T, TrackedAllocator<T, Category>>;
+
+template <class K, class V, MemoryCategory Category>
+using TrackedHashMap = phmap::flat_hash_map<
+    K,
+    V,
+    phmap::Hash<K>,
+    phmap::EqualTo<K>,
+    TrackedAllocator<std::pair<K const, V>, Category>>;
+} // namespace we
@@ -0,0 +1,315 @@
+#include "Voxelizer.h"
+
+#include <execution>
+#include <numeric>
+
+namespace we {
+namespace {
+using Point = std::array<double, 3>;
+
+constexpr uint32_t leafSize = 4;
+
+Point toPoint(Vec3 const& v) { return {v.x, v.y, v.z}; }
+
+Point sub(Point const& a, Point const& b) {
+    return {a[0] - b[0], a[1] - b[1], a[2] - b[2]};
+}
+
+double dot(Point const& a, Point const& b) {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+Point cross(Point const& a, Point const& b) {
+    return {
+        a[1] * b[2] - a[2] * b[1],
+        a[2] * b[0] - a[0] * b[2],
+        a[0] * b[1] - a[1] * b[0]
+    };
+}
+
+using Triangle = std::array<Point, 3>;
+
+Triangle getTriangle(Mesh const& mesh, uint32_t index) {
+    auto& t = mesh.triangles[index];
+    return {
+        toPoint(mesh.positions[t[0]]),
+        toPoint(mesh.positions[t[1]]),
+        toPoint(mesh.positions[t[2]])
+    };
+}
+
+// Separating axis test of a triangle against the block at pos; touching counts.
+bool overlapsBlock(Triangle const& triangle, BlockPos const& pos) {
+    constexpr double h = 0.5;
+
+    Point    center{pos.x + h, pos.y + h, pos.z + h};
+    Triangle v{
+        sub(triangle[0], center),
+        sub(triangle[1], center),
+        sub(triangle[2], center)
+    };
+    Triangle edges{sub(v[1], v[0]), sub(v[2], v[1]), sub(v[0], v[2])};
+
+    auto separates = [&](Point const& axis) {
+        double p0 = dot(axis, v[0]), p1 = dot(axis, v[1]), p2 = dot(axis, v[2]);
+        double r  = h * (std::abs(axis[0]) + std::abs(axis[1]) + std::abs(axis[2]));
+        return std::min({p0, p1, p2}) > r || std::max({p0, p1, p2}) < -r;
+    };
+    for (int i = 0; i < 3; ++i) {
+        Point unit{};
+        unit[i] = 1;
+        if (separates(unit)) return false;
+        for (auto& edge : edges) {
+            if (separates(cross(unit, edge))) return false;
+        }
+    }
+    return !separates(cross(edges[0], edges[1]));
+}
+
+// Positive when (y, z) is left of a b in the yz plane.
+double edge(Point const& a, Point const& b, double y, double z) {
+    return (b[1] - a[1]) * (z - a[2]) - (b[2] - a[2]) * (y - a[1]);
+}
+
+struct Crossing {
+    double x;
+    int    winding;
+};
+
+// Where the x axis ray through (y, z) crosses the triangle, if it does. Points on
+// an edge count for only one of the triangles sharing it: the edge function ties
+// go to edges pointing +z, or -y when flat, after turning the projection ccw.
+std::optional<Crossing> crossX(Triangle const& t, double y, double z) {
+    double area = edge(t[0], t[1], t[2][1], t[2][2]);
+    if (area == 0) {
+        return std::nullopt;
+    }
+    int  winding = area > 0 ? 1 : -1;
+    auto a = t[0], b = area > 0 ? t[1] : t[2], c = area > 0 ? t[2] : t[1];
+
+    std::array<double, 3> w{edge(b, c, y, z), edge(c, a, y, z), edge(a, b, y, z)};
+    std::array<std::pair<Point const*, Point const*>, 3> edges{
+        std::pair{&b, &c},
+        std::pair{&c, &a},
+        std::pair{&a, &b}
+    };
+    for (int i = 0; i < 3; ++i) {
+        if (w[i] > 0) continue;
+        if (w[i] < 0) return std::nullopt;
+        double du = (*edges[i].second)[1] - (*edges[i].first)[1];
+        double dv = (*edges[i].second)[2] - (*edges[i].first)[2];
+        if (!(dv > 0 || (dv == 0 && du < 0))) return std::nullopt;
+    }
+    double sum = w[0] + w[1] + w[2];
+    return Crossing{(w[0] * a[0] + w[1] * b[0] + w[2] * c[0]) / sum, winding};
+}
+} // namespace
+
+Mesh::Color Mesh::colorAt(uint32_t triangle, Vec3 const& point) const {
+    Color res{1, 1, 1};
+    if (!triangleColors.empty()) {
+        res = triangleColors[triangle];
+    }
+    if (colors.empty()) {
+        return res;
+    }
+    // barycentric coordinates of the point projected onto the triangle
+    auto  t  = getTriangle(*this, triangle);
+    auto  e0 = sub(t[1], t[0]), e1 = sub(t[2], t[0]), p = sub(toPoint(point), t[0]);
+    double d00 = dot(e0, e0), d01 = dot(e0, e1), d11 = dot(e1, e1);
+    double d20 = dot(p, e0), d21 = dot(p, e1);
+    double den = d00 * d11 - d01 * d01;
+    double v   = den == 0 ? 0 : std::clamp((d11 * d20 - d01 * d21) / den, 0.0, 1.0);
+    double w   = den == 0 ? 0 : std::clamp((d00 * d21 - d01 * d20) / den, 0.0, 1.0 - v);
+
+    auto& index = triangles[triangle];
+    for (int k = 0; k < 3; ++k) {
+        res[k] *= (float)((1 - v - w) * colors[index[0]][k] + v * colors[index[1]][k]
+                          + w * colors[index[2]][k]);
+    }
+    return res;
+}
+
+TriangleBvh::TriangleBvh(Mesh const& mesh) {
+    auto count = (uint32_t)mesh.triangles.size();
+    boxes.resize(count);
+    std::vector<std::array<float, 3>> centroids(count);
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& t = mesh.triangles[i];
+        auto& a = mesh.positions[t[0]];
+        auto& b = mesh.positions[t[1]];
+        auto& c = mesh.positions[t[2]];
+        boxes[i] = {
+            {std::min({a.x, b.x, c.x}),
+             std::min({a.y, b.y, c.y}),
+             std::min({a.z, b.z, c.z})},
+            {std::max({a.x, b.x, c.x}),
+             std::max({a.y, b.y, c.y}),
+             std::max({a.z, b.z, c.z})}
+        };
+        for (int k = 0; k < 3; ++k) {
+            centroids[i][k] = (boxes[i].min[k] + boxes[i].max[k]) / 2;
+        }
+    }
+    order.resize(count);
+    std::iota(order.begin(), order.end(), 0u);
+    if (count == 0) {
+        return;
+    }
+    nodes.reserve(2 * (count / leafSize) + 1);
+
+    auto build = [&](auto&& self, uint32_t first, uint32_t last) -> uint32_t {
+        auto index = (uint32_t)nodes.size();
+        nodes.emplace_back();
+        Box box = boxes[order[first]];
+        Box spread{centroids[order[first]], centroids[order[first]]};
+        for (uint32_t i = first; i < last; ++i) {
+            for (int k = 0; k < 3; ++k) {
+                box.min[k]    = std::min(box.min[k], boxes[order[i]].min[k]);
+                box.max[k]    = std::max(box.max[k], boxes[order[i]].max[k]);
+                spread.min[k] = std::min(spread.min[k], centroids[order[i]][k]);
+                spread.max[k] = std::max(spread.max[k], centroids[order[i]][k]);
+            }
+        }
+        int axis = 0;
+        for (int k = 1; k < 3; ++k) {
+            if (spread.max[k] - spread.min[k] > spread.max[axis] - spread.min[axis]) {
+                axis = k;
+            }
+        }
+        if (last - first <= leafSize || spread.max[axis] == spread.min[axis]) {
+            nodes[index] = {box, first, last - first};
+            return index;
+        }
+        auto mid = first + (last - first) / 2;
+        std::nth_element(
+            order.begin() + first,
+            order.begin() + mid,
+            order.begin() + last,
+            [&](uint32_t l, uint32_t r) {
+                return centroids[l][axis] < centroids[r][axis];
+            }
+        );
+        self(self, first, mid);
+        auto second  = self(self, mid, last);
+        nodes[index] = {box, second, 0};
+        return index;
+    };
+    build(build, 0, count);
+}
+
+VoxelizeResult voxelize(
+    Mesh const&            mesh,
+    TriangleBvh const&     bvh,
+    bool                   solid,
+    bool                   surface,
+    std::stop_token const& stop
+) {
+    VoxelizeResult res;
+    if (bvh.empty()) {
+        return res;
+    }
+    auto& bounds = bvh.bounds();
+    BlockPos min{
+        (int)std::floor(bounds.min[0]),
+        (int)std::floor(bounds.min[1]),
+        (int)std::floor(bounds.min[2])
+    };
+    BlockPos max{
+        (int)std::floor(bounds.max[0]),
+        (int)std::floor(bounds.max[1]),
+        (int)std::floor(bounds.max[2])
+    };
+
+    struct Task {
+        int                                      ty;
+        int                                      tz;
+        SparseBlockSet                           blocks;
+        phmap::flat_hash_map<BlockPos, uint32_t> surface;
+    };
+    std::vector<Task> tasks;
+    for (int tz = min.z >> 4; tz <= max.z >> 4; ++tz) {
+        for (int ty = min.y >> 4; ty <= max.y >> 4; ++ty) {
+            tasks.push_back({ty, tz, {}, {}});
+        }
+    }
+    std::for_each(std::execution::par, tasks.begin(), tasks.end(), [&](Task& task) {
+        if (stop.stop_requested()) {
+            return;
+        }
+        BlockPos from{
+            min.x,
+            std::max(min.y, task.ty << 4),
+            std::max(min.z, task.tz << 4)
+        };
+        BlockPos to{
+            max.x,
+            std::min(max.y, (task.ty << 4) + 15),
+            std::min(max.z, (task.tz << 4) + 15)
+        };
+
+        TriangleBvh::Box strip{
+            {bounds.min[0], (float)from.y, (float)from.z},
+            {bounds.max[0], (float)to.y + 1, (float)to.z + 1}
+        };
+        bvh.query(strip, [&](uint32_t index) {
+            auto triangle = getTriangle(mesh, index);
+            BlockPos lo{to}, hi{from};
+            for (int k = 0; k < 3; ++k) {
+                BlockPos v{
+                    (int)std::floor(triangle[k][0]),
+                    (int)std::floor(triangle[k][1]),
+                    (int)std::floor(triangle[k][2])
+                };
+                lo = {std::min(lo.x, v.x), std::min(lo.y, v.y), std::min(lo.z, v.z)};
+                hi = {std::max(hi.x, v.x), std::max(hi.y, v.y), std::max(hi.z, v.z)};
+            }
+            for (int y = std::max(lo.y, from.y); y <= std::min(hi.y, to.y); ++y) {
+                for (int z = std::max(lo.z, from.z); z <= std::min(hi.z, to.z); ++z) {
+                    for (int x = lo.x; x <= hi.x; ++x) {
+                        BlockPos pos{x, y, z};
+                        if (overlapsBlock(triangle, pos)) {
+                            task.blocks.set(pos);
+                            if (surface) task.surface.try_emplace(pos, index);
+                        }
+                    }
+                }
+            }
+        });
+        if (!solid || stop.stop_requested()) {
+            return;
+        }
+        std::vector<Crossing> crossings;
+        for (int y = from.y; y <= to.y; ++y) {
+            for (int z = from.z; z <= to.z; ++z) {
+                double cy = y + 0.5, cz = z + 0.5;
+                crossings.clear();
+                TriangleBvh::Box ray{
+                    {bounds.min[0], (float)cy, (float)cz},
+                    {bounds.max[0], (float)cy, (float)cz}
+                };
+                bvh.query(ray, [&](uint32_t index) {
+                    if (auto crossing = crossX(getTriangle(mesh, index), cy, cz)) {
+                        crossings.push_back(*crossing);
+                    }
+                });
+                std::ranges::sort(crossings, {}, &Crossing::x);
+                int winding = 0;
+                for (size_t i = 0; i + 1 < crossings.size(); ++i) {
+                    winding += crossings[i].winding;
+                    if (winding == 0) continue;
+                    // centres x + 0.5 in [crossing i, crossing i + 1)
+                    int x0 = (int)std::ceil(crossings[i].x - 0.5);
+                    int x1 = (int)std::ceil(crossings[i + 1].x - 0.5) - 1;
+                    if (x0 <= x1) task.blocks.setSpan(y, z, x0, x1);
+                }
+            }
+        }
+    });
+    for (auto& task : tasks) {
+        res.blocks.merge(task.blocks);
+        res.surface.merge(task.surface);
+    }
+    return res;
+}
+} // namespace we
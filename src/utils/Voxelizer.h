@@ -0,0 +1,98 @@
+#pragma once
+
+#include "utils/SparseBlockSet.h"
+#include "worldedit/Global.h"
+
+#include <stop_token>
+
+namespace we {
+// Triangle mesh in block space: block (x, y, z) spans [x, x + 1) on each axis.
+struct Mesh {
+    using Color = std::array<float, 3>;
+
+    std::vector<Vec3>                    positions;
+    std::vector<Color>                   colors; // per position, may be empty
+    std::vector<std::array<uint32_t, 3>> triangles;
+    std::vector<Color>                   triangleColors; // per triangle, may be empty
+
+    // Linear rgb of a triangle at a point, from its vertex and material colours.
+    Color colorAt(uint32_t triangle, Vec3 const& point) const;
+};
+
+// Bounding volume hierarchy over the triangles of a mesh, split at the median
+// centroid of the longest axis down to leaves of a few triangles.
+class TriangleBvh {
+public:
+    struct Box {
+        std::array<float, 3> min;
+        std::array<float, 3> max;
+
+        bool overlaps(Box const& o) const {
+            return min[0] <= o.max[0] && o.min[0] <= max[0] && min[1] <= o.max[1]
+                && o.min[1] <= max[1] && min[2] <= o.max[2] && o.min[2] <= max[2];
+        }
+    };
+
+    struct Node {
+        Box      box;
+        uint32_t first; // first triangle of a leaf, second child of an inner node
+        uint32_t count; // 0 for inner nodes, whose first child follows them
+    };
+
+private:
+    std::vector<Node>     nodes;
+    std::vector<uint32_t> order;
+    std::vector<Box>      boxes;
+
+public:
+    explicit TriangleBvh(Mesh const&);
+
+    Box const& bounds() const { return nodes.front().box; }
+
+    bool empty() const { return order.empty(); }
+
+    // Calls todo with every triangle whose bounds overlap box.
+    template <class Fn>
+    void query(Box const& box, Fn&& todo) const {
+        if (empty()) {
+            return;
+        }
+        std::array<uint32_t, 64> stack;
+        size_t                   top{};
+        stack[top++] = 0;
+        while (top > 0) {
+            auto& node = nodes[stack[--top]];
+            if (!node.box.overlaps(box)) {
+                continue;
+            }
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    if (boxes[order[i]].overlaps(box)) todo(order[i]);
+                }
+            } else {
+                stack[top++] = node.first;
+                stack[top++] = (uint32_t)(&node - nodes.data()) + 1;
+            }
+        }
+    }
+};
+
+struct VoxelizeResult {
+    SparseBlockSet blocks;
+    // With surface requested, a triangle touching each shell block.
+    phmap::flat_hash_map<BlockPos, uint32_t> surface;
+};
+
+// Voxelizes a mesh, strips of sub chunks along x in parallel. Shell blocks are
+// those a triangle overlaps by a separating axis test; with solid, the block
+// centres of every x row are also filled where the winding number of the
+// crossings before them is non-zero. Strips left once stop is requested are
+// skipped, leaving the result partial.
+VoxelizeResult voxelize(
+    Mesh const&,
+    TriangleBvh const&,
+    bool                   solid,
+    bool                   surface = false,
+    std::stop_token const& stop    = {}
+);
+} // namespace we
@@ -0,0 +1,168 @@
+#include "BiomeEdit.h"
+#include "data/History.h"
+#include "data/Telemetry.h"
+#include "region/Region.h"
+#include "world/ChunkSync.h"
+#include "world/SubChunkTiles.h"
+
+#include <mc/world/level/biome/Biome.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <mc/world/level/chunk/SubChunkStorage.h>
+
+#include <execution>
+
+namespace we {
+// The biome layer of a sub chunk by its absolute index, null if not allocated.
+static SubChunkStorage<Biome>* getBiomeStorage(LevelChunk const& chunk, int index) {
+    auto& layers = *chunk.mBiomes;
+    index       -= chunk.getMinSubChunkIndex();
+    return index >= 0 && index < (int)layers.size() ? layers[index].get() : nullptr;
+}
+
+size_t setBiomes(
+    BlockSource&   blockSource,
+    Region const&  region,
+    Biome const&   biome,
+    HistoryRecord& record
+) {
+    auto box  = region.getBoundingBox();
+    box.min.y = std::max(box.min.y, (int)blockSource.getMinHeight());
+    box.max.y = std::min(box.max.y, blockSource.getMaxHeight() - 1);
+    if (box.min.y > box.max.y) {
+        return 0;
+    }
+    auto minHeight = blockSource.getMinHeight();
+
+    std::optional<OperationContext::PhaseScope> phase{std::in_place, Phase::Iterate};
+
+    struct Task {
+        SubChunkTile                  tile;
+        LevelChunk const*             chunk;
+        std::bitset<4096>             mask;
+        std::optional<SubChunkBiomes> old;
+    };
+    std::vector<Task> tasks;
+    auto              tiles = getSubChunkTiles(box);
+    OperationContext::addChunkLookups(tiles.size());
+    for (auto& tile : tiles) {
+        if (auto* chunk = blockSource.getChunk(tile.chunk)) {
+            tasks.push_back({tile, chunk, {}, {}});
+            auto size = tile.box.getSideLength();
+            OperationContext::addTouched((uint64)size.x * size.y * size.z);
+        }
+    }
+    OperationContext::noteMemory(tasks.capacity() * sizeof(Task));
+    // the blocks inside, on this thread as regions needn't answer concurrently
+    for (auto& [tile, chunk, mask, old] : tasks) {
+        bool whole = region.containsBox(tile.box);
+        for (int y = tile.box.min.y; y <= tile.box.max.y; ++y) {
+            for (int z = tile.box.min.z; z <= tile.box.max.z; ++z) {
+                for (int x = tile.box.min.x; x <= tile.box.max.x; ++x) {
+                    BlockPos pos{x, y, z};
+                    if (whole || region.contains(pos)) {
+                        mask.set(toStorageIndex(pos));
+                    }
+                }
+            }
+        }
+    }
+    // read in parallel, nothing is written yet
+    std::for_each(std::execution::par, tasks.begin(), tasks.end(), [&](Task& task) {
+        auto& [tile, chunk, mask, old] = task;
+        SubChunkPos pos{tile.chunk.x, tile.index, tile.chunk.z};
+        auto*       storage = getBiomeStorage(*chunk, tile.index);
+        if (storage) {
+            auto& uniform = storage->getElement(0);
+            if (storage->isUniform(uniform)) {
+                if (&uniform != &biome) {
+                    old.emplace(&uniform);
+                } else {
+                    mask.reset();
+                }
+                return;
+            }
+        }
+        std::array<Biome const*, 4096> biomes{};
+        Biome const*                   first{};
+        for (ushort i = 0; i < 4096; ++i) {
+            if (!mask[i]) {
+                continue;
+            }
+            auto& current =
+                storage ? storage->getElement(i)
+                        : chunk->getBiome(ChunkBlockPos{toBlockPos(pos, i), minHeight});
+            if (&current == &biome) {
+                mask.reset(i);
+                continue;
+            }
+            biomes[i] = &current;
+            first     = first ? first : &current;
+        }
+        if (!first) {
+            return;
+        }
+        // the indices left out repeat one that is in, so they take no palette
+        for (auto& b : biomes) {
+            b = b ? b : first;
+        }
+        old.emplace(std::span<Biome const* const, 4096>{biomes});
+    });
+
+    phase.emplace(Phase::Write);
+    SubChunkBiomes                 biomes{&biome};
+    size_t                         changed{};
+    phmap::flat_hash_set<ChunkPos> chunks;
+    for (auto& [tile, chunk, mask, old] : tasks) {
+        if (!old) {
+            continue;
+        }
+        SubChunkPos pos{tile.chunk.x, tile.index, tile.chunk.z};
+        changed += writeBiomes(blockSource, pos, mask, biomes);
+        chunks.insert(tile.chunk);
+        record.add(HistoryRecord::BiomeChange{pos, mask, std::move(*old), biomes});
+    }
+    resendChunks(blockSource, chunks);
+    OperationContext::addWritten(changed);
+    return changed;
+}
+
+size_t writeBiomes(
+    BlockSource&             blockSource,
+    SubChunkPos const&       pos,
+    std::bitset<4096> const& mask,
+    SubChunkBiomes const&    biomes
+) {
+    OperationContext::addChunkLookups(1);
+    auto* chunk = blockSource.getChunk(ChunkPos{pos.x, pos.z});
+    if (!chunk) {
+        return 0;
+    }
+    auto   minHeight = blockSource.getMinHeight();
+    auto*  storage   = getBiomeStorage(*chunk, pos.y);
+    size_t res{};
+    for (ushort i = 0; i < 4096; ++i) {
+        if (!mask[i]) {
+            continue;
+        }
+        auto& biome = *biomes[i];
+        if (storage) {
+            if (&storage->getElement(i) == &biome) {
+                continue;
+            }
+            // a full palette has to grow, which only the chunk can do
+            if (storage->setElement(i, biome)) {
+                res++;
+                continue;
+            }
+        }
+        ChunkBlockPos blockPos{toBlockPos(pos, i), minHeight};
+        if (&chunk->getBiome(blockPos) != &biome) {
+            chunk->_setBiome(biome, blockPos, false);
+            // the chunk may have allocated or replaced the layer
+            storage = getBiomeStorage(*chunk, pos.y);
+            res++;
+        }
+    }
+    return res;
+}
+} // namespace we
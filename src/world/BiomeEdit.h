@@ -0,0 +1,36 @@
+#pragma once
+
+#include "utils/PalettedArray.h"
+#include "worldedit/Global.h"
+
+#include <bitset>
+
+class Biome;
+
+namespace we {
+class Region;
+class HistoryRecord;
+
+// The biomes of one sub chunk, indexed like its block storage.
+using SubChunkBiomes = PalettedArray<Biome const*, 4096>;
+
+// Sets biome over every block of a region, a sub chunk at a time: the chunk is
+// looked up once per sub chunk, their biomes are read in parallel, and what is
+// replaced is recorded palette compressed, usually one or two biomes each.
+// Returns the count of blocks whose biome changed.
+size_t setBiomes(
+    BlockSource&   blockSource,
+    Region const&  region,
+    Biome const&   biome,
+    HistoryRecord& record
+);
+
+// Writes biomes at the storage indices set in mask of one sub chunk.
+// Returns the count of blocks whose biome changed.
+size_t writeBiomes(
+    BlockSource&             blockSource,
+    SubChunkPos const&       pos,
+    std::bitset<4096> const& mask,
+    SubChunkBiomes const&    biomes
+);
+} // namespace we
@@ -0,0 +1,38 @@
+#include "BlockEntity.h"
+
+#include <mc/dataloadhelper/DefaultDataLoadHelper.h>
+#include <mc/world/item/SaveContextFactory.h>
+#include <mc/world/level/block/actor/BlockActor.h>
+
+namespace we {
+SharedNbt saveBlockEntity(BlockSource& blockSource, BlockPos const& pos) {
+    auto blockActor = blockSource.getBlockEntity(pos);
+    if (!blockActor) {
+        return {};
+    }
+    CompoundTag nbt;
+    if (!blockActor->save(nbt, SaveContextFactory::createCloneSaveContext())) {
+        return {};
+    }
+    return SharedNbt::intern(nbt.toBinaryNbt());
+}
+
+bool loadBlockEntity(
+    BlockSource&     blockSource,
+    BlockPos const&  pos,
+    SharedNbt const& nbt
+) {
+    auto blockActor = blockSource.getBlockEntity(pos);
+    if (!blockActor || !nbt) {
+        return false;
+    }
+    auto tag = CompoundTag::fromBinaryNbt(nbt.getBinary());
+    if (!tag) {
+        return false;
+    }
+    DefaultDataLoadHelper helper;
+    blockActor->load(blockSource.getLevel(), *tag, helper);
+    blockActor->refresh(blockSource);
+    return true;
+}
+} // namespace we
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "data/SharedNbt.h"
+#include "worldedit/Global.h"
+
+namespace we {
+// The NBT of the block entity at pos, empty if there is none.
+SharedNbt saveBlockEntity(BlockSource&, BlockPos const&);
+
+// Loads nbt into the block entity at pos. False if there is none.
+bool loadBlockEntity(BlockSource&, BlockPos const&, SharedNbt const& nbt);
+} // namespace we
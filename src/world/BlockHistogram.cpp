@@ -0,0 +1,124 @@
+#include "BlockHistogram.h"
+#include "data/Telemetry.h"
+#include "region/Region.h"
+#include "world/SubChunkTiles.h"
+
+#include <mc/world/level/BedrockBlocks.h>
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <mc/world/level/chunk/SubChunk.h>
+#include <mc/world/level/chunk/SubChunkStorage.h>
+
+#include <execution>
+
+namespace we {
+void BlockHistogram::add(Block const& block, uint64 count) {
+    auto& [ptr, n] = counts[block.getRuntimeId()];
+    ptr            = &block;
+    n             += count;
+}
+
+void BlockHistogram::merge(BlockHistogram const& other) {
+    for (auto& [id, entry] : other.counts) {
+        auto& [ptr, n] = counts[id];
+        ptr            = entry.first;
+        n             += entry.second;
+    }
+}
+
+uint64 BlockHistogram::total() const {
+    uint64 res{};
+    for (auto& [id, entry] : counts) {
+        res += entry.second;
+    }
+    return res;
+}
+
+std::vector<std::pair<Block const*, uint64>> BlockHistogram::sorted() const {
+    std::vector<std::pair<Block const*, uint64>> res;
+    res.reserve(counts.size());
+    for (auto& [id, entry] : counts) {
+        res.push_back(entry);
+    }
+    std::ranges::sort(res, std::greater{}, [](auto& e) { return e.second; });
+    return res;
+}
+
+// Counts a whole sub chunk from its storage without touching positions.
+static void countWhole(SubChunk const* subChunk, BlockHistogram& res) {
+    auto* storage = subChunk ? (*subChunk->mBlocks)[0].get() : nullptr;
+    if (!storage) {
+        res.add(*BedrockBlocks::mAir, 4096);
+        return;
+    }
+    auto& first = storage->getElement(0);
+    if (storage->isUniform(first)) {
+        res.add(first, 4096);
+        return;
+    }
+    // runs of equal blocks are common, count them before touching the map
+    Block const* last = &first;
+    uint64       run  = 0;
+    for (ushort i = 0; i < 4096; ++i) {
+        auto* block = &storage->getElement(i);
+        if (block != last) {
+            res.add(*last, run);
+            last = block;
+            run  = 0;
+        }
+        run++;
+    }
+    res.add(*last, run);
+}
+
+BlockHistogram BlockHistogram::count(BlockSource& blockSource, Region const& region) {
+    OperationContext::PhaseScope phase{Phase::Iterate};
+
+    auto box  = region.getBoundingBox();
+    box.min.y = std::max(box.min.y, (int)blockSource.getMinHeight());
+    box.max.y = std::min(box.max.y, blockSource.getMaxHeight() - 1);
+    if (box.min.y > box.max.y) {
+        return {};
+    }
+    auto minHeight = blockSource.getMinHeight();
+
+    struct Task {
+        SubChunkTile      tile;
+        LevelChunk const* chunk;
+        BlockHistogram    histogram;
+    };
+    std::vector<Task> tasks;
+    auto              tiles = getSubChunkTiles(box);
+    OperationContext::addChunkLookups(tiles.size());
+    for (auto& tile : tiles) {
+        if (auto* chunk = blockSource.getChunk(tile.chunk)) {
+            tasks.push_back({tile, chunk, {}});
+            auto size = tile.box.getSideLength();
+            OperationContext::addTouched((uint64)size.x * size.y * size.z);
+        }
+    }
+    OperationContext::noteMemory(tasks.capacity() * sizeof(Task));
+    std::for_each(std::execution::par, tasks.begin(), tasks.end(), [&](Task& task) {
+        auto& [tile, chunk, histogram] = task;
+        if (tile.isWhole() && region.containsBox(tile.box)) {
+            countWhole(chunk->getSubChunk((short)tile.index), histogram);
+            return;
+        }
+        for (int y = tile.box.min.y; y <= tile.box.max.y; ++y) {
+            for (int z = tile.box.min.z; z <= tile.box.max.z; ++z) {
+                for (int x = tile.box.min.x; x <= tile.box.max.x; ++x) {
+                    BlockPos pos{x, y, z};
+                    if (region.contains(pos)) {
+                        histogram.add(chunk->getBlock(ChunkBlockPos{pos, minHeight}));
+                    }
+                }
+            }
+        }
+    });
+    BlockHistogram res;
+    for (auto& task : tasks) {
+        res.merge(task.histogram);
+    }
+    return res;
+}
+} // namespace we
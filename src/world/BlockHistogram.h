@@ -0,0 +1,31 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+class Block;
+
+namespace we {
+class Region;
+
+// Block counts keyed by runtime id. Names are left to whoever prints them.
+class BlockHistogram {
+    phmap::flat_hash_map<uint, std::pair<Block const*, uint64>> counts;
+
+public:
+    void add(Block const& block, uint64 count = 1);
+
+    void merge(BlockHistogram const&);
+
+    uint64 total() const;
+
+    // Every counted block, most frequent first.
+    std::vector<std::pair<Block const*, uint64>> sorted() const;
+
+    // Counts the blocks of a region in its loaded chunks.
+    // Sub chunks wholly inside the region are counted from their block storage,
+    // a uniform one at once; the rest are masked block by block. Tiles are
+    // counted in parallel while the calling thread waits, so call it from the
+    // server thread.
+    static BlockHistogram count(BlockSource&, Region const&);
+};
+} // namespace we
@@ -0,0 +1,88 @@
+#include "BlockMove.h"
+#include "data/History.h"
+#include "region/Region.h"
+#include "utils/SparseBlockSet.h"
+#include "world/BlockEntity.h"
+
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/block/BlockLegacy.h>
+
+namespace we {
+size_t moveBlocks(
+    BlockSource&     blockSource,
+    Region const&    region,
+    BlockPos const&  offset,
+    BlockPair const& fill,
+    HistoryRecord&   record
+) {
+    if (offset == BlockPos{0, 0, 0}) {
+        return 0;
+    }
+    int  minY     = blockSource.getMinHeight();
+    int  maxY     = blockSource.getMaxHeight() - 1;
+    auto isSource = [&](BlockPos const& pos) {
+        return pos.y >= minY && pos.y <= maxY && region.contains(pos);
+    };
+    auto box  = region.getBoundingBox();
+    box.min.y = std::max(box.min.y, minY);
+    box.max.y = std::min(box.max.y, maxY);
+    if (box.min.y > box.max.y) {
+        return 0;
+    }
+
+    // A source lands on a block that comes earlier in this order, so its layer
+    // is either the one being moved, read in full already, or one moved before.
+    int first = box.min.y >> 4;
+    int last  = box.max.y >> 4;
+    if (offset.y > 0) {
+        std::swap(first, last);
+    }
+    int step = offset.y > 0 ? -1 : 1;
+
+    SparseBlockSet vacated;
+    size_t         changed{};
+    for (int layer = first; layer != last + step; layer += step) {
+        BoundingBox slice = box;
+        slice.min.y       = std::max(box.min.y, layer << 4);
+        slice.max.y       = std::min(box.max.y, (layer << 4) + 15);
+        bool whole        = region.containsBox(slice);
+
+        EditBuffer                              buffer;
+        std::vector<HistoryRecord::BlockEntity> entities; // at their destination
+        {
+            OperationContext::PhaseScope phase{Phase::Iterate};
+            for (int y = slice.min.y; y <= slice.max.y; ++y) {
+                for (int z = slice.min.z; z <= slice.max.z; ++z) {
+                    for (int x = slice.min.x; x <= slice.max.x; ++x) {
+                        BlockPos pos{x, y, z};
+                        if (!whole && !region.contains(pos)) {
+                            continue;
+                        }
+                        auto blocks = getBlockPair(blockSource, pos);
+                        buffer.set(pos + offset, blocks);
+                        if (blocks.block->getLegacyBlock().hasBlockEntity()) {
+                            if (auto nbt = saveBlockEntity(blockSource, pos)) {
+                                entities.emplace_back(pos + offset, std::move(nbt));
+                            }
+                        }
+                        // nothing moves onto it
+                        if (!isSource(pos - offset)) {
+                            vacated.set(pos);
+                        }
+                    }
+                }
+            }
+        }
+        changed += buffer.flush(blockSource, &record);
+        for (auto& [pos, nbt] : entities) {
+            // a block left as it was keeps its entity, which undo must restore
+            if (auto old = saveBlockEntity(blockSource, pos)) {
+                record.add(pos, std::move(old));
+            }
+            loadBlockEntity(blockSource, pos, nbt);
+            record.addPlaced(pos, std::move(nbt));
+        }
+    }
+    return changed + fillSet(blockSource, vacated, fill, &record);
+}
+} // namespace we
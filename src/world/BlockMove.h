@@ -0,0 +1,24 @@
+#pragma once
+
+#include "world/EditBuffer.h"
+#include "worldedit/Global.h"
+
+namespace we {
+class Region;
+class HistoryRecord;
+
+// Moves both layers of every block of a region by offset in place, the blocks
+// it leaves becoming fill. Like memmove it goes against the move, a sub chunk
+// layer at a time, so every layer is read before anything lands on it and only
+// one layer is held. Vacated blocks are filled in one pass at the end. Only the
+// blocks actually changed are recorded. Block entities move along, loaded into
+// the blocks landing after each layer is written.
+// Returns the count of blocks changed.
+size_t moveBlocks(
+    BlockSource&     blockSource,
+    Region const&    region,
+    BlockPos const&  offset,
+    BlockPair const& fill,
+    HistoryRecord&   record
+);
+} // namespace we
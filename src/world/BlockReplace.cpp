@@ -0,0 +1,133 @@
+#include "BlockReplace.h"
+#include "data/History.h"
+#include "data/Telemetry.h"
+#include "region/Region.h"
+#include "world/SubChunkTiles.h"
+
+#include <mc/world/level/BedrockBlocks.h>
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/block/BlockLegacy.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <mc/world/level/chunk/SubChunk.h>
+#include <mc/world/level/chunk/SubChunkStorage.h>
+
+#include <execution>
+
+namespace we {
+static bool hasBlockEntity(Block const& block) {
+    return block.getLegacyBlock().hasBlockEntity();
+}
+
+// Marks the storage indices of a whole sub chunk holding block.
+static void
+matchWhole(SubChunk const* subChunk, Block const& block, std::bitset<4096>& mask) {
+    auto* storage = subChunk ? (*subChunk->mBlocks)[0].get() : nullptr;
+    if (!storage) {
+        if (&block == BedrockBlocks::mAir) {
+            mask.set();
+        }
+        return;
+    }
+    auto& first = storage->getElement(0);
+    if (storage->isUniform(first)) {
+        if (&first == &block) {
+            mask.set();
+        }
+        return;
+    }
+    for (ushort i = 0; i < 4096; ++i) {
+        if (&storage->getElement(i) == &block) {
+            mask.set(i);
+        }
+    }
+}
+
+size_t replaceBlocks(
+    BlockSource&   blockSource,
+    Region const&  region,
+    Block const&   from,
+    Block const&   to,
+    HistoryRecord& record
+) {
+    if (&from == &to) {
+        return 0;
+    }
+    if (hasBlockEntity(from) || hasBlockEntity(to)) {
+        EditBuffer buffer;
+        {
+            OperationContext::PhaseScope phase{Phase::Iterate};
+            region.forEachBlockInRegion([&](BlockPos const& pos) {
+                if (&blockSource.getBlock(pos) == &from) {
+                    buffer.set(pos, {&to, &blockSource.getExtraBlock(pos)});
+                }
+            });
+        }
+        return buffer.flush(blockSource, &record);
+    }
+
+    auto box  = region.getBoundingBox();
+    box.min.y = std::max(box.min.y, (int)blockSource.getMinHeight());
+    box.max.y = std::min(box.max.y, blockSource.getMaxHeight() - 1);
+    if (box.min.y > box.max.y) {
+        return 0;
+    }
+    auto minHeight = blockSource.getMinHeight();
+
+    std::optional<OperationContext::PhaseScope> phase{std::in_place, Phase::Iterate};
+
+    struct Task {
+        SubChunkTile      tile;
+        LevelChunk const* chunk;
+        std::bitset<4096> mask;
+    };
+    std::vector<Task> tasks;
+    auto              tiles = getSubChunkTiles(box);
+    OperationContext::addChunkLookups(tiles.size());
+    for (auto& tile : tiles) {
+        if (auto* chunk = blockSource.getChunk(tile.chunk)) {
+            tasks.push_back({tile, chunk, {}});
+            auto size = tile.box.getSideLength();
+            OperationContext::addTouched((uint64)size.x * size.y * size.z);
+        }
+    }
+    OperationContext::noteMemory(tasks.capacity() * sizeof(Task));
+    // match in parallel, nothing is written yet; getBoundingBox above built
+    // whatever the region caches, so the workers only read it
+    std::for_each(std::execution::par, tasks.begin(), tasks.end(), [&](Task& task) {
+        auto& [tile, chunk, mask] = task;
+        if (tile.isWhole() && region.containsBox(tile.box)) {
+            matchWhole(chunk->getSubChunk((short)tile.index), from, mask);
+            return;
+        }
+        for (int y = tile.box.min.y; y <= tile.box.max.y; ++y) {
+            for (int z = tile.box.min.z; z <= tile.box.max.z; ++z) {
+                for (int x = tile.box.min.x; x <= tile.box.max.x; ++x) {
+                    BlockPos pos{x, y, z};
+                    if (region.contains(pos)
+                        && &chunk->getBlock(ChunkBlockPos{pos, minHeight}) == &from) {
+                        mask.set(toStorageIndex(pos));
+                    }
+                }
+            }
+        }
+    });
+
+    phase.emplace(Phase::Write);
+    size_t changed{};
+    for (auto& [tile, chunk, mask] : tasks) {
+        if (mask.none()) {
+            continue;
+        }
+        SubChunkPos pos{tile.chunk.x, tile.index, tile.chunk.z};
+        for (int i = 0; i < 4096; ++i) {
+            if (mask[i] && !setBlockLayer(blockSource, toBlockPos(pos, i), false, to)) {
+                mask.reset(i);
+            }
+        }
+        changed += mask.count();
+        record.add({pos, false, &from, &to, mask});
+    }
+    OperationContext::addWritten(changed);
+    return changed;
+}
+} // namespace we
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+class Block;
+
+namespace we {
+class Region;
+class HistoryRecord;
+
+// Replaces every from with to on the block layer of a region, recording one
+// masked substitution per sub chunk instead of an entry per block.
+// Whole sub chunks inside the region are matched from their block storage, and
+// skipped at once when uniform with another block. Blocks with block entities
+// take the per block path so their records stay complete.
+// Returns the count of blocks changed.
+size_t replaceBlocks(
+    BlockSource&   blockSource,
+    Region const&  region,
+    Block const&   from,
+    Block const&   to,
+    HistoryRecord& record
+);
+} // namespace we
@@ -0,0 +1,42 @@
+#include "ChunkSync.h"
+
+#include <mc/network/packet/LevelChunkPacket.h>
+#include <mc/world/actor/player/Player.h>
+#include <mc/world/level/Level.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+
+namespace we {
+void resendChunks(BlockSource& blockSource, phmap::flat_hash_set<ChunkPos> const& chunks) {
+    if (chunks.empty()) {
+        return;
+    }
+    for (auto& pos : chunks) {
+        if (auto chunk = blockSource.getChunk(pos)) {
+            chunk->setUnsaved();
+        }
+    }
+    auto dim = blockSource.getDimensionId();
+    blockSource.getLevel().forEachPlayer([&](Player& player) {
+        if (player.getDimensionId() != dim || player.isSimulatedPlayer()) {
+            return true;
+        }
+        auto center = ChunkPos{player.getFeetBlockPos()};
+        auto radius = player.getChunkRadius();
+        for (auto& pos : chunks) {
+            if (std::abs(pos.x - center.x) > radius || std::abs(pos.z - center.z) > radius) {
+                continue;
+            }
+            // only the header, the client then asks for the sub chunks and
+            // gets them as they are now
+            LevelChunkPacket packet;
+            packet.mPos                           = pos;
+            packet.mDimensionType                 = dim;
+            packet.mCacheEnabled                  = false;
+            packet.mClientNeedsToRequestSubChunks = true;
+            packet.mClientRequestSubChunkLimit    = -1;
+            player.sendNetworkPacket(packet);
+        }
+        return true;
+    });
+}
+} // namespace we
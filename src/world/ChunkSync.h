@@ -0,0 +1,10 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+namespace we {
+// Marks chunks changed so they are saved, and sends them again to the players
+// who have them in view. Needed after writes clients aren't told about, such
+// as biomes, which have no update packet of their own.
+void resendChunks(BlockSource&, phmap::flat_hash_set<ChunkPos> const& chunks);
+} // namespace we
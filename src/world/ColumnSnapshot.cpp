@@ -0,0 +1,84 @@
+#include "ColumnSnapshot.h"
+#include "world/SubChunkTiles.h"
+
+#include <mc/world/level/BedrockBlocks.h>
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <mc/world/level/chunk/SubChunk.h>
+#include <mc/world/level/chunk/SubChunkStorage.h>
+
+namespace we {
+// The block filling a whole layer of a sub chunk, if one does.
+template <class Storage>
+static Block const* getUniform(Storage const* storage) {
+    if (!storage) {
+        return BedrockBlocks::mAir;
+    }
+    auto& first = storage->getElement(0);
+    return storage->isUniform(first) ? &first : nullptr;
+}
+
+ColumnSnapshot::ColumnSnapshot(
+    BlockSource&               blockSource,
+    BoundingBox const&         b,
+    std::pmr::memory_resource* resource
+)
+: box(b),
+  sizez(b.max.z - b.min.z + 1),
+  columns(resource) {
+    box.min.y = std::max(box.min.y, (int)blockSource.getMinHeight());
+    box.max.y = std::min(box.max.y, blockSource.getMaxHeight() - 1);
+    columns.resize((size_t)(box.max.x - box.min.x + 1) * sizez);
+    if (box.min.y > box.max.y) {
+        return;
+    }
+
+    // Tiles come bottom up in each chunk, so every column gets its runs in
+    // order. Sub chunks store columns contiguously, a whole layer of one block
+    // is a single run per column.
+    auto tiles = getSubChunkTiles(box);
+    OperationContext::addChunkLookups(tiles.size());
+    for (auto& tile : tiles) {
+        auto  size  = tile.box.getSideLength();
+        auto* chunk = blockSource.getChunk(tile.chunk);
+        OperationContext::addTouched((uint64)size.x * size.y * size.z);
+        if (!chunk) {
+            for (int x = tile.box.min.x; x <= tile.box.max.x; ++x) {
+                for (int z = tile.box.min.z; z <= tile.box.max.z; ++z) {
+                    auto& column = getColumn(x, z);
+                    for (int y = tile.box.min.y; y <= tile.box.max.y; ++y) {
+                        appendRun(column, y, 1, getBlockPair(blockSource, {x, y, z}));
+                    }
+                }
+            }
+            continue;
+        }
+        auto* subChunk = chunk->getSubChunk((short)tile.index);
+        auto* blocks   = subChunk ? (*subChunk->mBlocks)[0].get() : nullptr;
+        auto* extras   = subChunk ? (*subChunk->mBlocks)[1].get() : nullptr;
+        auto* block    = getUniform(blocks);
+        auto* extra    = getUniform(extras);
+        for (int x = tile.box.min.x; x <= tile.box.max.x; ++x) {
+            for (int z = tile.box.min.z; z <= tile.box.max.z; ++z) {
+                auto& column = getColumn(x, z);
+                if (block && extra) {
+                    appendRun(column, tile.box.min.y, size.y, BlockPair{block, extra});
+                    continue;
+                }
+                for (int y = tile.box.min.y; y <= tile.box.max.y; ++y) {
+                    auto index = toStorageIndex({x, y, z});
+                    appendRun(
+                        column,
+                        y,
+                        1,
+                        BlockPair{
+                            block ? block : &blocks->getElement(index),
+                            extra ? extra : &extras->getElement(index)
+                        }
+                    );
+                }
+            }
+        }
+    }
+}
+} // namespace we
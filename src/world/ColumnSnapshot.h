@@ -0,0 +1,103 @@
+#pragma once
+
+#include "data/Telemetry.h"
+#include "utils/ColumnRuns.h"
+#include "world/EditBuffer.h"
+
+#include <execution>
+#include <memory_resource>
+
+namespace we {
+// Every (x, z) column of a box read once from the world as a run list, a sub
+// chunk at a time. Capturing needs the server thread, the captured columns can
+// then be transformed from any thread. The columns live on resource, the
+// operation arena by default.
+class ColumnSnapshot {
+public:
+    using Column = std::pmr::vector<ColumnRun<BlockPair>>;
+
+private:
+    BoundingBox              box;
+    int                      sizez;
+    std::pmr::vector<Column> columns;
+
+    size_t getIndex(int x, int z) const {
+        return (size_t)(x - box.min.x) * sizez + (z - box.min.z);
+    }
+
+    Column& getColumn(int x, int z) { return columns[getIndex(x, z)]; }
+
+public:
+    ColumnSnapshot(
+        BlockSource&,
+        BoundingBox const&,
+        std::pmr::memory_resource* resource = OperationContext::arena()
+    );
+
+    // Bytes a snapshot of box and its transformed columns take, with a few runs
+    // per sub chunk of a column.
+    static size_t estimateMemory(BoundingBox const& box) {
+        auto side = box.getSideLength();
+        auto runs = (uint64)((side.y + 15) / 16 + 1) * 4;
+        return (size_t)side.x * side.z * 2
+             * (sizeof(Column) + runs * sizeof(ColumnRun<BlockPair>));
+    }
+
+    BoundingBox const& getBoundingBox() const { return box; }
+
+    size_t size() const { return columns.size(); }
+
+    Pos2d getColumnPos(size_t index) const {
+        return {box.min.x + (int)(index / sizez), box.min.z + (int)(index % sizez)};
+    }
+
+    Column const& at(size_t index) const { return columns[index]; }
+
+    Column const& at(int x, int z) const { return columns[getIndex(x, z)]; }
+
+    // Runs transform(xz, column) -> Column for every column, the columns of a
+    // chunk together and the chunks in parallel, an empty result leaving the
+    // column as it is. Then writes the changed blocks passing keep into out,
+    // keep being called on this thread only.
+    template <class Fn, class Keep>
+    void transform(Fn&& fn, EditBuffer& out, Keep&& keep) const {
+        std::vector<std::invoke_result_t<Fn&, Pos2d, Column const&>> results(columns.size());
+        std::vector<ChunkPos>                                          chunks;
+        for (int cx = box.min.x >> 4; cx <= box.max.x >> 4; ++cx) {
+            for (int cz = box.min.z >> 4; cz <= box.max.z >> 4; ++cz) {
+                chunks.push_back(ChunkPos{cx, cz});
+            }
+        }
+        std::for_each(std::execution::par, chunks.begin(), chunks.end(), [&](ChunkPos pos) {
+            int minx = std::max(box.min.x, pos.x << 4);
+            int maxx = std::min(box.max.x, (pos.x << 4) + 15);
+            int minz = std::max(box.min.z, pos.z << 4);
+            int maxz = std::min(box.max.z, (pos.z << 4) + 15);
+            for (int x = minx; x <= maxx; ++x) {
+                for (int z = minz; z <= maxz; ++z) {
+                    auto i     = getIndex(x, z);
+                    results[i] = fn(Pos2d{x, z}, columns[i]);
+                }
+            }
+        });
+        for (size_t i = 0; i < columns.size(); ++i) {
+            auto xz = getColumnPos(i);
+            forEachChangedBlock<BlockPair>(
+                columns[i],
+                results[i],
+                [&](int y, BlockPair const& blocks) {
+                    BlockPos pos{xz.x, y, xz.z};
+                    if (keep(pos)) {
+                        out.set(pos, blocks);
+                    }
+                }
+            );
+        }
+    }
+
+    template <class Fn>
+    void transform(Fn&& fn, EditBuffer& out) const {
+        transform(std::forward<Fn>(fn), out, [](BlockPos const&) { return true; });
+    }
+};
+} // namespace we
@@ -0,0 +1,208 @@
+#include "EditBuffer.h"
+#include "data/History.h"
+#include "world/BlockEntity.h"
+#include "utils/SparseBlockSet.h"
+#include "utils/Spans.h"
+
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/block/BlockLegacy.h>
+
+namespace we {
+// send to clients, skip neighbour updates
+static constexpr int updateFlags = 2;
+
+optional_ref<BlockSource> getBlockSource(DimensionType dim) {
+    auto level = ll::service::getLevel();
+    if (!level) {
+        return nullptr;
+    }
+    if (auto dimension = level->getDimension(dim).lock(); dimension) {
+        return dimension->getBlockSourceFromMainChunkSource();
+    }
+    return nullptr;
+}
+
+BlockPair getBlockPair(BlockSource& blockSource, BlockPos const& pos) {
+    return {&blockSource.getBlock(pos), &blockSource.getExtraBlock(pos)};
+}
+
+bool setBlockPair(BlockSource& blockSource, BlockPos const& pos, BlockPair const& blocks) {
+    bool res{};
+    if (&blockSource.getExtraBlock(pos) != blocks.extra) {
+        res |= blockSource.setExtraBlock(pos, *blocks.extra, updateFlags);
+    }
+    if (&blockSource.getBlock(pos) != blocks.block) {
+        res |= blockSource.setBlock(pos, *blocks.block, updateFlags, nullptr, nullptr);
+    }
+    return res;
+}
+
+bool setBlockLayer(
+    BlockSource&    blockSource,
+    BlockPos const& pos,
+    bool            extra,
+    Block const&    block
+) {
+    if (extra) {
+        return &blockSource.getExtraBlock(pos) != &block
+            && blockSource.setExtraBlock(pos, block, updateFlags);
+    }
+    return &blockSource.getBlock(pos) != &block
+        && blockSource.setBlock(pos, block, updateFlags, nullptr, nullptr);
+}
+
+// Writes blocks over old, appending the change to record along with the block
+// entity the write destroys.
+static bool writeBlockPair(
+    BlockSource&     blockSource,
+    BlockPos const&  pos,
+    BlockPair const& old,
+    BlockPair const& blocks,
+    HistoryRecord*   record
+) {
+    if (old == blocks) {
+        return false;
+    }
+    SharedNbt nbt;
+    if (record && old.block != blocks.block
+        && old.block->getLegacyBlock().hasBlockEntity()) {
+        nbt = saveBlockEntity(blockSource, pos);
+    }
+    if (!setBlockPair(blockSource, pos, blocks)) {
+        return false;
+    }
+    if (record) {
+        record->add(pos, old, blocks);
+        if (nbt) {
+            record->add(pos, std::move(nbt));
+        }
+    }
+    return true;
+}
+
+size_t EditBuffer::estimateMemory(uint64 blocks) {
+    // the map at its 7/8 maximum load, with a control byte per slot
+    size_t buffer = (sizeof(std::pair<BlockPos const, BlockPair>) + 1) * 8 / 7;
+    // the copy flush sorts, with the replaced blocks
+    size_t sorted = sizeof(BlockPos) + 2 * sizeof(BlockPair);
+    return (size_t)blocks * (buffer + sorted + sizeof(HistoryRecord::Entry));
+}
+
+PendingWrites EditBuffer::sort(std::pmr::memory_resource* resource) {
+    using Write = PendingWrites::Write;
+    OperationContext::PhaseScope phase{Phase::Iterate};
+    OperationContext::addTouched(writes.size());
+    PendingWrites res{resource};
+    auto&         sorted = res.writes;
+    sorted.reserve(writes.size());
+    for (auto& [pos, blocks] : writes) {
+        sorted.push_back({pos, blocks, {}});
+    }
+    OperationContext::noteMemory(
+        sorted.capacity() * sizeof(Write)
+        + writes.size() * sizeof(std::pair<BlockPos, BlockPair>)
+    );
+    writes.clear();
+    std::ranges::sort(sorted, [](Write const& a, Write const& b) {
+        auto& l = a.pos;
+        auto& r = b.pos;
+        return std::tuple{l.x >> 4, l.z >> 4, l.y >> 4, l.y, l.z, l.x}
+             < std::tuple{r.x >> 4, r.z >> 4, r.y >> 4, r.y, r.z, r.x};
+    });
+    return res;
+}
+
+size_t PendingWrites::write(BlockSource& blockSource, HistoryRecord* record, size_t limit) {
+    auto slice = std::span{writes}.subspan(next, std::min(limit, remaining()));
+    next      += slice.size();
+    {
+        // what every write replaces; a write changing nothing is skipped below
+        OperationContext::PhaseScope phase{Phase::Capture};
+        for (auto& write : slice) {
+            write.old = getBlockPair(blockSource, write.pos);
+        }
+    }
+    OperationContext::PhaseScope phase{Phase::Write};
+    size_t                       changed{};
+    for (auto& [pos, blocks, old] : slice) {
+        changed += writeBlockPair(blockSource, pos, old, blocks, record);
+    }
+    OperationContext::addWritten(changed);
+    return changed;
+}
+
+size_t fillShape(
+    BlockSource&     blockSource,
+    SpanShape const& shape,
+    BlockPair const& blocks,
+    HistoryRecord*   record
+) {
+    OperationContext::PhaseScope phase{Phase::Write};
+    OperationContext::addTouched(shape.volume());
+
+    auto box  = shape.getBoundingBox();
+    box.min.y = std::max(box.min.y, (int)blockSource.getMinHeight());
+    box.max.y = std::min(box.max.y, blockSource.getMaxHeight() - 1);
+
+    size_t changed{};
+    for (int cx = box.min.x >> 4; cx <= box.max.x >> 4; ++cx) {
+        int minX = std::max(box.min.x, cx << 4);
+        int maxX = std::min(box.max.x, (cx << 4) + 15);
+        for (int cz = box.min.z >> 4; cz <= box.max.z >> 4; ++cz) {
+            int minZ = std::max(box.min.z, cz << 4);
+            int maxZ = std::min(box.max.z, (cz << 4) + 15);
+            for (int y = box.min.y; y <= box.max.y; ++y) {
+                for (int z = minZ; z <= maxZ; ++z) {
+                    for (auto& span : shape.at(y, z)) {
+                        int to = std::min(span.x1, maxX);
+                        for (int x = std::max(span.x0, minX); x <= to; ++x) {
+                            BlockPos pos{x, y, z};
+                            changed += writeBlockPair(
+                                blockSource,
+                                pos,
+                                getBlockPair(blockSource, pos),
+                                blocks,
+                                record
+                            );
+                        }
+                    }
+                }
+            }
+        }
+    }
+    OperationContext::addWritten(changed);
+    return changed;
+}
+
+size_t fillSet(
+    BlockSource&          blockSource,
+    SparseBlockSet const& set,
+    BlockPair const&      blocks,
+    HistoryRecord*        record
+) {
+    OperationContext::PhaseScope phase{Phase::Write};
+    OperationContext::addTouched(set.size());
+    int    minY = blockSource.getMinHeight();
+    int    maxY = blockSource.getMaxHeight() - 1;
+    size_t changed{};
+    set.forEachBlock([&](BlockPos const& pos) {
+        if (pos.y < minY || pos.y > maxY) {
+            return;
+        }
+        changed += writeBlockPair(
+            blockSource,
+            pos,
+            getBlockPair(blockSource, pos),
+            blocks,
+            record
+        );
+    });
+    OperationContext::addWritten(changed);
+    return changed;
+}
+
+size_t estimateFillSetMemory(uint64 blocks) {
+    size_t tile = sizeof(SparseBlockSet::Tile) / 16;
+    return (size_t)blocks * (sizeof(HistoryRecord::Entry) + tile);
+}
+} // namespace we
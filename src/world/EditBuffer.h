@@ -0,0 +1,123 @@
+#pragma once
+
+#include "data/Telemetry.h"
+#include "utils/TrackedAllocator.h"
+#include "worldedit/Global.h"
+
+class Block;
+
+namespace we {
+class HistoryRecord;
+class SpanShape;
+class SparseBlockSet;
+
+struct BlockPair {
+    Block const* block{};
+    Block const* extra{};
+
+    bool operator==(BlockPair const&) const = default;
+};
+
+optional_ref<BlockSource> getBlockSource(DimensionType);
+
+BlockPair getBlockPair(BlockSource&, BlockPos const&);
+
+bool setBlockPair(BlockSource&, BlockPos const&, BlockPair const&);
+
+// Sets only the given layer, extra being the liquid layer.
+bool setBlockLayer(BlockSource&, BlockPos const&, bool extra, Block const&);
+
+// Index of a block inside its sub chunk's storage, x major then z then y.
+inline ushort toStorageIndex(BlockPos const& pos) {
+    return (ushort)(((pos.x & 15) << 8) | ((pos.z & 15) << 4) | (pos.y & 15));
+}
+
+inline BlockPos toBlockPos(SubChunkPos const& subChunk, int index) {
+    return {
+        (subChunk.x << 4) | (index >> 8),
+        (subChunk.y << 4) | (index & 15),
+        (subChunk.z << 4) | ((index >> 4) & 15)
+    };
+}
+
+// The writes of an EditBuffer in flush order, for writing them a slice at a time.
+class PendingWrites {
+public:
+    struct Write {
+        BlockPos  pos;
+        BlockPair blocks;
+        BlockPair old;
+    };
+
+private:
+    std::pmr::vector<Write> writes;
+    size_t                  next{};
+
+public:
+    explicit PendingWrites(std::pmr::memory_resource* resource) : writes(resource) {}
+
+    size_t size() const { return writes.size(); }
+
+    size_t remaining() const { return writes.size() - next; }
+
+    bool done() const { return next == writes.size(); }
+
+    // Captures and writes up to limit of the next blocks, appending what they
+    // replaced to record. Returns the count of blocks actually changed.
+    size_t write(BlockSource&, HistoryRecord* record = nullptr, size_t limit = SIZE_MAX);
+
+    friend class EditBuffer;
+};
+
+// Pending block writes of one operation.
+// Positions are deduplicated, and flush writes them ordered by sub chunk.
+class EditBuffer {
+    TrackedHashMap<BlockPos, BlockPair, MemoryCategory::EditBuffer> writes;
+
+public:
+    // Peak bytes an operation writing blocks holds until it's flushed: the
+    // buffer, its sorted copy and the history record.
+    static size_t estimateMemory(uint64 blocks);
+
+    void set(BlockPos const& pos, BlockPair const& blocks) { writes[pos] = blocks; }
+
+    bool contains(BlockPos const& pos) const { return writes.contains(pos); }
+
+    size_t size() const { return writes.size(); }
+
+    bool empty() const { return writes.empty(); }
+
+    void clear() { writes.clear(); }
+
+    // Moves the pending blocks out in flush order. It reads no world, so it can
+    // run off the server thread, given a resource that outlives the operation.
+    PendingWrites sort(std::pmr::memory_resource* resource = OperationContext::arena());
+
+    // Writes and clears the pending blocks, appending what they replaced to record.
+    // Returns the count of blocks actually changed.
+    size_t flush(BlockSource& blockSource, HistoryRecord* record = nullptr) {
+        return sort().write(blockSource, record);
+    }
+};
+
+// Writes blocks over every span of shape, in the same sub chunk order as
+// EditBuffer::flush. Spans never overlap, so they bypass the buffer entirely.
+size_t fillShape(
+    BlockSource&,
+    SpanShape const&,
+    BlockPair const& blocks,
+    HistoryRecord*   record = nullptr
+);
+
+// Writes blocks over every block of set, in the same order.
+size_t fillSet(
+    BlockSource&,
+    SparseBlockSet const&,
+    BlockPair const& blocks,
+    HistoryRecord*   record = nullptr
+);
+
+// Peak bytes a set of that many blocks and fillSet over it hold: the history
+// and the set's tiles, one per 16 blocks at worst along a thin line.
+size_t estimateFillSetMemory(uint64 blocks);
+} // namespace we
@@ -0,0 +1,227 @@
+#include "EditScheduler.h"
+#include "worldedit/WorldEdit.h"
+
+namespace we {
+struct EditScheduler::State {
+    Job                            job;
+    std::shared_ptr<MemoryAccount> account;
+    std::shared_ptr<HistoryRecord> record;
+    std::optional<PendingWrites>   writes; // none if the compute failed
+    OperationStats                 stats;
+    size_t                         changed{};
+    std::atomic_bool               computed{};
+    std::stop_source               stop;
+
+    bool done() const { return !writes || writes->done(); }
+};
+
+// Locks are whole chunk columns, an edit changes lighting and heightmaps over
+// the full height anyway.
+static bool overlaps(BoundingBox const& a, BoundingBox const& b) {
+    return (a.min.x >> 4) <= (b.max.x >> 4) && (b.min.x >> 4) <= (a.max.x >> 4)
+        && (a.min.z >> 4) <= (b.max.z >> 4) && (b.min.z >> 4) <= (a.max.z >> 4);
+}
+
+EditScheduler::~EditScheduler() {
+    // the jobs hold what running computes read
+    stopComputes();
+}
+
+void EditScheduler::stopComputes() {
+    preparing.request_stop();
+    for (auto& state : jobs) {
+        state->stop.request_stop();
+    }
+    for (auto n = computing->load(); n; n = computing->load()) {
+        computing->wait(n);
+    }
+}
+
+void EditScheduler::shutdown() {
+    stopComputes();
+    for (auto& state : std::exchange(jobs, {})) {
+        state->job.compute = nullptr;
+        auto finish        = std::exchange(state->job.finish, nullptr);
+        if (state->record->empty()) {
+            continue;
+        }
+        try {
+            finish({std::move(state->record), state->changed, std::move(state->stats)});
+        } catch (...) {
+            ll::error_utils::printCurrentException(logger());
+        }
+    }
+    lastTick.reset();
+}
+
+void EditScheduler::submit(Job job) {
+    auto state     = std::make_shared<State>();
+    state->account = MemoryAccount::current();
+    state->record  = std::make_shared<HistoryRecord>(job.dim);
+    state->job     = std::move(job);
+    jobs.push_back(state);
+    computing->fetch_add(1);
+    ll::thread::ThreadPoolExecutor::getDefault().execute(
+        [state, computing = computing]() mutable {
+            {
+                MemoryAccount::Scope account{state->account};
+                OperationContext     operation{state->job.name};
+                try {
+                    EditBuffer buffer;
+                    auto       stop = state->stop.get_token();
+                    state->job.compute(buffer, stop);
+                    // kept for ticks after the operation and its arena are gone
+                    if (!stop.stop_requested()) {
+                        state->writes.emplace(buffer.sort(std::pmr::new_delete_resource()));
+                    }
+                } catch (...) {
+                    ll::error_utils::printCurrentException(logger());
+                }
+                state->stats = operation.finish();
+            }
+            state->computed.store(true, std::memory_order_release);
+            state.reset();
+            computing->fetch_sub(1);
+            computing->notify_all();
+        }
+    );
+    scheduleTick();
+}
+
+void EditScheduler::prepare(std::function<void(std::stop_token const& stop)> task) {
+    computing->fetch_add(1);
+    ll::thread::ThreadPoolExecutor::getDefault().execute(
+        [task = std::move(task), stop = preparing.get_token(), computing = computing](
+        ) mutable {
+            try {
+                task(stop);
+            } catch (...) {
+                ll::error_utils::printCurrentException(logger());
+            }
+            task = nullptr;
+            computing->fetch_sub(1);
+            computing->notify_all();
+        }
+    );
+}
+
+bool EditScheduler::isLocked(DimensionType dim, BoundingBox const& area) const {
+    return std::ranges::any_of(jobs, [&](auto& state) {
+        return state->job.dim == dim && overlaps(state->job.area, area);
+    });
+}
+
+bool EditScheduler::hasJobs(mce::UUID const& owner) const {
+    return std::ranges::any_of(jobs, [&](auto& state) {
+        return state->job.owner == owner;
+    });
+}
+
+bool EditScheduler::isBlocked(State const& job) const {
+    for (auto& state : jobs) {
+        if (state.get() == &job) {
+            return false;
+        }
+        if (state->job.dim == job.job.dim && overlaps(state->job.area, job.job.area)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void EditScheduler::scheduleTick() {
+    if (ticking) {
+        return;
+    }
+    ticking = true;
+    ll::thread::ServerThreadExecutor::getDefault().executeAfter(
+        [weak = weak_from_this()] {
+            auto self = weak.lock();
+            if (!self) {
+                return;
+            }
+            self->ticking = false;
+            self->tick();
+            if (!self->jobs.empty()) {
+                self->scheduleTick();
+            }
+        },
+        1_tick
+    );
+}
+
+void EditScheduler::tick() {
+    auto                           now = Clock::now();
+    std::optional<Clock::duration> serverTick;
+    if (lastTick) {
+        serverTick = now - *lastTick;
+    }
+    lastTick = now;
+
+    std::vector<std::shared_ptr<State>> ready, writing;
+    for (auto& state : jobs) {
+        if (!state->computed.load(std::memory_order_acquire)) {
+            continue;
+        }
+        state->job.compute = nullptr;
+        if (isBlocked(*state)) {
+            continue;
+        }
+        ready.push_back(state);
+        if (!state->done()) {
+            writing.push_back(state);
+        }
+    }
+    if (!writing.empty()) {
+        // shares of the budget by priority, the odd blocks going to the next
+        // jobs in turn
+        auto                budget = governor.getBudget();
+        std::vector<size_t> limits(writing.size());
+        uint64              weights{};
+        for (auto& state : writing) {
+            weights += state->job.priority;
+        }
+        size_t odd = budget;
+        for (size_t i = 0; i < writing.size(); ++i) {
+            limits[i]  = (size_t)(budget * writing[i]->job.priority / weights);
+            odd       -= limits[i];
+        }
+        for (size_t i = 0; i < odd; ++i) {
+            limits[(turn + i) % writing.size()]++;
+        }
+        size_t processed{};
+        for (size_t i = 0; i < writing.size(); ++i) {
+            auto& state = *writing[i];
+            processed  += std::min(limits[i], state.writes->remaining());
+            OperationContext operation{state.job.name};
+            if (auto blockSource = getBlockSource(state.job.dim); blockSource) {
+                state.changed +=
+                    state.writes->write(*blockSource, state.record.get(), limits[i]);
+            } else {
+                // the dimension unloaded, what was written stays undoable
+                state.writes.reset();
+            }
+            state.stats.merge(operation.finish());
+        }
+        governor.update(processed, Clock::now() - now, serverTick);
+    }
+    turn++;
+    for (auto& state : ready) {
+        if (!state->done()) {
+            continue;
+        }
+        std::erase(jobs, state);
+        // the pool may still hold the state, what the callback captures goes here
+        auto finish = std::exchange(state->job.finish, nullptr);
+        try {
+            finish({std::move(state->record), state->changed, std::move(state->stats)});
+        } catch (...) {
+            ll::error_utils::printCurrentException(logger());
+        }
+    }
+    if (jobs.empty()) {
+        // the next tick follows a break, it can't tell how long a tick is
+        lastTick.reset();
+    }
+}
+} // namespace we
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "data/History.h"
+#include "data/Telemetry.h"
+#include "world/EditBuffer.h"
+#include "world/TickGovernor.h"
+#include "worldedit/Global.h"
+
+#include <mc/platform/UUID.h>
+
+#include <stop_token>
+
+namespace we {
+// Runs edits too big for one command callback. An edit computes its writes on
+// the thread pool, then writes them on the server thread a slice per tick, the
+// edits writing at once sharing the budget of the TickGovernor by priority.
+// From submission until its last write an edit locks the chunks of its area.
+// Edits whose areas overlap write in submission order, so their history records
+// undo in the order they were made; others compute and write alongside.
+class EditScheduler : public std::enable_shared_from_this<EditScheduler> {
+public:
+    struct Result {
+        std::shared_ptr<HistoryRecord> record;
+        size_t                         changed{};
+        OperationStats                 stats; // the compute and every slice
+    };
+
+    struct Job {
+        mce::UUID     owner;
+        std::string   name;
+        DimensionType dim;
+        BoundingBox   area; // no write may leave the chunks of it
+        uint          priority{1}; // weight of its share, see TickGovernor
+
+        // Fills the buffer on the thread pool. It must not touch the world, nor
+        // anything the server thread may change meanwhile, and should return
+        // soon once stop is requested, the buffer then being dropped. Its
+        // captures are released on the server thread.
+        std::function<void(EditBuffer&, std::stop_token const& stop)> compute;
+
+        // Runs on the server thread after the last write.
+        std::function<void(Result)> finish;
+    };
+
+private:
+    struct State;
+
+    using Clock = std::chrono::steady_clock;
+
+    std::deque<std::shared_ptr<State>> jobs; // in submission order
+    TickGovernor                       governor;
+    size_t                             turn{}; // who gets the odd blocks this tick
+    bool                               ticking{};
+    std::optional<Clock::time_point>   lastTick; // while ticking without a break
+
+    // Computes and preparations still running on the pool, stopped and waited
+    // for on shutdown.
+    std::shared_ptr<std::atomic<size_t>> computing =
+        std::make_shared<std::atomic<size_t>>();
+    std::stop_source                     preparing;
+
+    void scheduleTick();
+
+    // Stops the computes and waits for them to return.
+    void stopComputes();
+
+    void tick();
+
+    // Whether an earlier job still pending locks chunks of job's area.
+    bool isBlocked(State const& job) const;
+
+public:
+    explicit EditScheduler(Config::SchedulerConfig const& config) : governor(config) {}
+
+    EditScheduler(EditScheduler const&)            = delete;
+    EditScheduler& operator=(EditScheduler const&) = delete;
+
+    ~EditScheduler();
+
+    // Stops every pending edit on the server thread, before what the finishers
+    // use goes away: the computes are stopped, and an edit that wrote part of
+    // its buffer finishes with that part, undoable like a whole edit.
+    void shutdown();
+
+    // Queues an edit, charging its memory to the current MemoryAccount.
+    void submit(Job job);
+
+    // Runs the work an edit needs before its area is known on the thread pool,
+    // stopped and waited for on shutdown like a compute.
+    void prepare(std::function<void(std::stop_token const& stop)> task);
+
+    // Whether a pending edit locks chunks of area.
+    bool isLocked(DimensionType, BoundingBox const& area) const;
+
+    // Whether owner has edits pending.
+    bool hasJobs(mce::UUID const& owner) const;
+
+    size_t size() const { return jobs.size(); }
+
+    TickGovernor const& getGovernor() const { return governor; }
+};
+} // namespace we
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+namespace we {
+// The part of a box inside one sub chunk.
+struct SubChunkTile {
+    ChunkPos    chunk;
+    int         index; // sub chunk y, blockY >> 4
+    BoundingBox box;
+
+    // Whether the tile is the whole 16x16x16 sub chunk.
+    bool isWhole() const {
+        return box.max.x - box.min.x == 15 && box.max.y - box.min.y == 15
+            && box.max.z - box.min.z == 15;
+    }
+};
+
+// Splits box into its sub chunk tiles, ordered by chunk column then height.
+inline std::vector<SubChunkTile> getSubChunkTiles(BoundingBox const& box) {
+    std::vector<SubChunkTile> res;
+    for (int cx = box.min.x >> 4; cx <= box.max.x >> 4; ++cx) {
+        for (int cz = box.min.z >> 4; cz <= box.max.z >> 4; ++cz) {
+            for (int sy = box.min.y >> 4; sy <= box.max.y >> 4; ++sy) {
+                BlockPos origin{cx << 4, sy << 4, cz << 4};
+                res.push_back({
+                    ChunkPos{cx, cz},
+                    sy,
+                    {{std::max(origin.x, box.min.x),
+                      std::max(origin.y, box.min.y),
+                      std::max(origin.z, box.min.z)},
+                     {std::min(origin.x + 15, box.max.x),
+                      std::min(origin.y + 15, box.max.y),
+                      std::min(origin.z + 15, box.max.z)}}
+                });
+            }
+        }
+    }
+    return res;
+}
+} // namespace we
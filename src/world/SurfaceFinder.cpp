@@ -0,0 +1,80 @@
+#include "SurfaceFinder.h"
+
+#include <mc/world/level/block/Block.h>
+#include <mc/world/level/chunk/LevelChunk.h>
+#include <mc/world/level/chunk/SubChunk.h>
+#include <mc/world/level/chunk/SubChunkStorage.h>
+
+namespace we {
+static bool isAirSubChunk(SubChunk const* subChunk) {
+    if (!subChunk) {
+        return true;
+    }
+    auto& storage = (*subChunk->mBlocks)[0];
+    if (!storage) {
+        return true;
+    }
+    auto& first = storage->getElement(0);
+    return first.isAir() && storage->isUniform(first);
+}
+
+static uint64 packColumn(int x, int z) {
+    return ((uint64)(uint)x << 32) | (uint64)(uint)z;
+}
+
+SurfaceFinder::SurfaceFinder(BlockSource& blockSource, int minY, int maxY, Filter filter)
+: blockSource(blockSource),
+  minY(std::max(minY, (int)blockSource.getMinHeight())),
+  maxY(std::min(maxY, blockSource.getMaxHeight() - 1)),
+  minHeight(blockSource.getMinHeight()),
+  filter(std::move(filter)) {}
+
+SurfaceFinder::ChunkCache const& SurfaceFinder::getChunk(ChunkPos const& pos) {
+    auto [iter, inserted] = chunks.try_emplace(pos);
+    auto& cache           = iter->second;
+    if (!inserted) {
+        return cache;
+    }
+    cache.chunk = blockSource.getChunk(pos);
+    if (!cache.chunk) {
+        return cache;
+    }
+    for (int y = minY >> 4; y <= maxY >> 4; ++y) {
+        if (isAirSubChunk(cache.chunk->getSubChunk((short)y))) {
+            cache.airSubChunks |= 1ull << (y - (minHeight >> 4));
+        }
+    }
+    return cache;
+}
+
+int SurfaceFinder::findHighest(int x, int z) {
+    auto& cache = getChunk(ChunkPos{x >> 4, z >> 4});
+    if (!cache.chunk) {
+        return minY - 1;
+    }
+    for (int y = maxY; y >= minY; --y) {
+        if (cache.airSubChunks & (1ull << ((y >> 4) - (minHeight >> 4)))) {
+            // jump to the top of the sub chunk below
+            y &= ~15;
+            continue;
+        }
+        BlockPos pos{x, y, z};
+        auto&    block = cache.chunk->getBlock(ChunkBlockPos{pos, minHeight});
+        if (block.isAir()) {
+            continue;
+        }
+        if (!filter || filter(pos, block)) {
+            return y;
+        }
+    }
+    return minY - 1;
+}
+
+int SurfaceFinder::getHighest(int x, int z) {
+    auto key = packColumn(x, z);
+    if (auto iter = columns.find(key); iter != columns.end()) {
+        return iter->second;
+    }
+    return columns.emplace(key, findHighest(x, z)).first->second;
+}
+} // namespace we
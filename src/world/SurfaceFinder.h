@@ -0,0 +1,47 @@
+#pragma once
+
+#include "worldedit/Global.h"
+
+class Block;
+class LevelChunk;
+
+namespace we {
+// Finds the highest non-air block of columns inside one operation.
+// Chunks, their empty sub chunks and answered columns are cached, so one finder
+// should be shared by every column query of a brush stroke or a command.
+class SurfaceFinder {
+public:
+    // Compiled once by the caller, only evaluated on non-air candidates.
+    using Filter = std::function<bool(BlockPos const&, Block const&)>;
+
+private:
+    struct ChunkCache {
+        LevelChunk* chunk{};
+        uint64      airSubChunks{};
+    };
+
+    BlockSource& blockSource;
+    int          minY;
+    int          maxY;
+    short        minHeight;
+    Filter       filter;
+
+    phmap::flat_hash_map<ChunkPos, ChunkCache> chunks;
+    phmap::flat_hash_map<uint64, int>          columns;
+
+    ChunkCache const& getChunk(ChunkPos const&);
+
+    int findHighest(int x, int z);
+
+public:
+    SurfaceFinder(BlockSource&, int minY, int maxY, Filter filter = {});
+
+    int getMinY() const { return minY; }
+    int getMaxY() const { return maxY; }
+
+    // Returns minY - 1 when the column doesn't have any matching block.
+    int getHighest(int x, int z);
+
+    int getHighest(Pos2d xz) { return getHighest(xz.x, xz.z); }
+};
+} // namespace we
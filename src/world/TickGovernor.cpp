@@ -0,0 +1,52 @@
+#include "TickGovernor.h"
+
+namespace we {
+TickGovernor::TickGovernor(Config::SchedulerConfig const& settings) : config(settings) {
+    config.min_blocks_per_tick = std::max<size_t>(config.min_blocks_per_tick, 1);
+    config.max_blocks_per_tick =
+        std::max(config.max_blocks_per_tick, config.min_blocks_per_tick);
+    budget = std::clamp(
+        (double)config.blocks_per_tick,
+        (double)config.min_blocks_per_tick,
+        (double)config.max_blocks_per_tick
+    );
+}
+
+uint TickGovernor::getPriority(CommandPermissionLevel level) const {
+    auto& priority = config.priority;
+    uint  res;
+    switch (level) {
+    case CommandPermissionLevel::Any:
+        res = priority.any;
+        break;
+    case CommandPermissionLevel::GameDirectors:
+        res = priority.game_directors;
+        break;
+    case CommandPermissionLevel::Admin:
+        res = priority.admin;
+        break;
+    case CommandPermissionLevel::Host:
+        res = priority.host;
+        break;
+    default:
+        res = priority.owner;
+        break;
+    }
+    return std::max(res, 1u);
+}
+
+void TickGovernor::update(size_t processed, Duration write, std::optional<Duration> tick) {
+    if (write.count() > config.write_ms_per_tick
+        || (tick && tick->count() > config.lag_tick_ms)) {
+        budget /= 2;
+    } else if (processed >= getBudget()) {
+        // growing a budget the edits don't use up says nothing
+        budget += (double)config.increase_blocks_per_tick;
+    }
+    budget = std::clamp(
+        budget,
+        (double)config.min_blocks_per_tick,
+        (double)config.max_blocks_per_tick
+    );
+}
+} // namespace we
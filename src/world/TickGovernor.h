@@ -0,0 +1,33 @@
+#pragma once
+
+#include "data/Config.h"
+#include "worldedit/Global.h"
+
+#include <chrono>
+
+namespace we {
+// Adapts the blocks scheduled edits write per tick to what the server can take,
+// additive increase while it keeps up, multiplicative decrease once writing
+// outgrows its share of the tick or the server falls behind. Big edits slow
+// down rather than the server.
+class TickGovernor {
+public:
+    using Duration = std::chrono::duration<double, std::milli>;
+
+private:
+    Config::SchedulerConfig config;
+    double                  budget;
+
+public:
+    explicit TickGovernor(Config::SchedulerConfig const&);
+
+    size_t getBudget() const { return (size_t)budget; }
+
+    // The weight of an edit's share of the budget.
+    uint getPriority(CommandPermissionLevel) const;
+
+    // Adjusts the budget after a tick that went through processed blocks in
+    // write. tick is how long the server tick before it took, if known.
+    void update(size_t processed, Duration write, std::optional<Duration> tick);
+};
+} // namespace we
@@ -56,17 +56,60 @@ bool WorldEdit::enable() {
         loadConfig();
     }
     mLocalContextManager = std::make_shared<LocalContextManager>(*this);
+    mTelemetry.emplace(getConfig().log.server_operation_count);
+    mScheduler = std::make_shared<EditScheduler>(getConfig().scheduler);
     setupCommands();
     return true;
 }
 
 bool WorldEdit::disable() {
+    if (mScheduler) {
+        mScheduler->shutdown();
+    }
+    mScheduler.reset();
     saveConfig();
     mConfig.reset();
     mLocalContextManager.reset();
+    mTelemetry.reset();
     return true;
 }
 
+void WorldEdit::recordOperation(OperationStats const& stats) {
+    using namespace std::chrono;
+    mTelemetry->record(stats);
+
+    auto& config = getConfig().log;
+    auto  level  = stats.total >= milliseconds(config.slow_operation_ms)
+                     ? config.slow_operation_log_level
+                     : config.operation_log_level;
+    std::string phases;
+    for (size_t i = 0; i < phaseCount; ++i) {
+        if (stats.phases[i] != OperationStats::Duration{}) {
+            phases += fmt::format(
+                "{0}{1} {2:.2f}ms",
+                phases.empty() ? "" : ", ",
+                getPhaseName((Phase)i),
+                duration<double, std::milli>(stats.phases[i]).count()
+            );
+        }
+    }
+    getLogger().log(
+        level,
+        "{0}: {1} of {2} block(s) written in {3:.2f}ms, {4:.4g} blocks/s, {5} chunk "
+        "lookup(s), {6} KiB peak, {7} KiB of temporaries in {8} new block(s); {9}",
+        stats.name,
+        stats.blocksWritten,
+        stats.blocksTouched,
+        duration<double, std::milli>(stats.total).count(),
+        stats.blocksPerSecond(),
+        stats.chunkLookups,
+        stats.peakMemory / 1024,
+        stats.arenaBytes / 1024,
+        stats.allocations,
+        phases
+    );
+}
+
 bool WorldEdit::unload() { return true; }
 
 } // namespace we
@@ -4,6 +4,7 @@
 #include "Macros.h"
 #include "data/Config.h"
 #include "data/LocalContextManager.h"
+#include "world/EditScheduler.h"
 
 #include <ll/api/mod/NativeMod.h>
 
@@ -28,6 +29,14 @@ public:
         return *mLocalContextManager;
     }
 
+    [[nodiscard]] Telemetry& getTelemetry() { return *mTelemetry; }
+
+    [[nodiscard]] EditScheduler& getScheduler() { return *mScheduler; }
+
+    // Adds a finished operation to the server telemetry and logs it, at
+    // Config::log levels.
+    void recordOperation(OperationStats const&);
+
     [[nodiscard]] std::filesystem::path getConfigPath() const;
 
     bool loadConfig();
@@ -47,6 +56,8 @@ private:
     std::unique_ptr<bsci::GeometryGroup> mGeometryGroup;
     std::optional<Config>                mConfig;
     std::shared_ptr<LocalContextManager> mLocalContextManager;
+    std::optional<Telemetry>             mTelemetry;
+    std::shared_ptr<EditScheduler>       mScheduler;
 };
 
 inline ll::io::Logger& logger() { return WorldEdit::getInstance().getLogger(); }
@@ -6,6 +6,8 @@ add_repositories("liteldev-repo https://github.com/LiteLDev/xmake-repo.git")
 add_repositories("oeo-repo https://github.com/OEOTYAN/xmake-repo.git")
 
 
+-- The mod builds only against the Windows server; the benchmarks build anywhere.
+if is_plat("windows") then
 add_requires("levilamina 02d2546eff2516d3272f4bff5bab31682c60a45e")
 add_requires("levibuildscript")
 
@@ -32,3 +34,41 @@ target("WorldEdit") -- Change this to your mod name.
     set_kind("shared")
     set_languages("c++20")
     set_symbols("debug")
+end
+
+-- Micro-benchmarks of the engine kernels against an in memory world, with the
+-- server headers replaced by bench/headless: xmake build WorldEditBench
+target("WorldEditBench")
+    set_default(false)
+    set_kind("binary")
+    if is_plat("windows") then
+        add_cxflags("/utf-8")
+        add_defines("NOMINMAX", "UNICODE")
+    else
+        add_syslinks("tbb") -- std::execution::par
+    end
+    add_files("bench/**.cpp")
+    add_files(
+        "src/region/*.cpp",
+        "src/data/History.cpp",
+        "src/data/SharedNbt.cpp",
+        "src/data/Telemetry.cpp",
+        "src/world/BiomeEdit.cpp",
+        "src/world/BlockHistogram.cpp",
+        "src/world/BlockMove.cpp",
+        "src/world/BlockReplace.cpp",
+        "src/world/ColumnSnapshot.cpp",
+        "src/world/EditBuffer.cpp",
+        "src/world/SurfaceFinder.cpp",
+        "src/utils/Arena.cpp",
+        "src/utils/Blur.cpp",
+        "src/utils/Bresenham.cpp",
+        "src/utils/Expression.cpp",
+        "src/utils/GeoContainer.cpp",
+        "src/utils/Math.cpp",
+        "src/utils/Trace.cpp",
+        "src/utils/TrackedAllocator.cpp",
+        "src/utils/Voxelizer.cpp"
+    )
+    add_includedirs("bench/headless", "src", "bench")
+    set_languages("c++23")